@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+// Compares backend -> wrapper key lookups, the call made for every GLFW key
+// event: the shipped KeyMap, the same table forced into the paged layout and
+// the dense table inputmap::toKey used before StaticLookup validated its
+// entries (with the missing BackendFirst offset fixed).
+
+#include "backend/glfw/glfw_input_map.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace cwin;
+
+namespace {
+
+struct PagedKeyMapTraits : GlfwKeyMapTraits
+{
+    static constexpr size_t PagingMinSavings = 0;
+};
+
+using PagedKeyMap = StaticLookup<PagedKeyMapTraits, inputmap::KeyEntries>;
+
+class LegacyKeyMap
+{
+public:
+    static constexpr size_t BackendMinVal = GLFW_KEY_SPACE;
+    static constexpr size_t BackendCount = GLFW_KEY_LAST - GLFW_KEY_SPACE + 1;
+
+    constexpr LegacyKeyMap()
+    {
+        map_.fill(Key::Unknown);
+        for (const auto& entry : inputmap::KeyEntries) {
+            map_[static_cast<size_t>(entry.backendVal) - BackendMinVal] = entry.wrapperVal;
+        }
+    }
+
+    Key toWrapper(int k) const noexcept
+    {
+        size_t idx = static_cast<size_t>(k) - BackendMinVal;
+        if (idx >= BackendCount) {
+            return Key::Unknown;
+        }
+        return map_[idx];
+    }
+
+private:
+    std::array<Key, BackendCount> map_{};
+};
+
+constexpr LegacyKeyMap Legacy;
+
+// Key codes as they arrive from GLFW, with some unknown ones mixed in
+std::vector<int> makeInput(size_t count)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, inputmap::KeyEntries.size() - 1);
+    std::uniform_int_distribution<int> roll(0, 15);
+    std::vector<int> input(count);
+    for (int& key : input) {
+        key = roll(rng) == 0 ? GLFW_KEY_UNKNOWN : inputmap::KeyEntries[pick(rng)].backendVal;
+    }
+    return input;
+}
+
+template <typename Fn>
+double measure(const char* name, const std::vector<int>& input, Fn&& lookup)
+{
+    constexpr int Rounds = 2000;
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < Rounds; ++round) {
+        for (int key : input) {
+            checksum += static_cast<uint64_t>(lookup(key));
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    double perLookup = elapsed.count() / (static_cast<double>(input.size()) * Rounds);
+    std::printf(
+        "%-10s %6.2f ns/lookup  (checksum %llu)\n",
+        name,
+        perLookup,
+        static_cast<unsigned long long>(checksum));
+    return perLookup;
+}
+
+}  // namespace
+
+int main()
+{
+    std::vector<int> input = makeInput(4096);
+
+    for (int key = GLFW_KEY_UNKNOWN; key <= GLFW_KEY_LAST + 1; ++key) {
+        Key expected = Legacy.toWrapper(key);
+        if (inputmap::KeyMap::toWrapper(key) != expected
+            || PagedKeyMap::toWrapper(key) != expected) {
+            std::printf("lookups disagree for key %d\n", key);
+            return 1;
+        }
+    }
+
+    std::printf(
+        "KeyMap is %s, %zu bytes; paged layout %zu bytes\n",
+        inputmap::KeyMap::IsPaged ? "paged" : "dense",
+        inputmap::KeyMap::TableBytes,
+        PagedKeyMap::TableBytes);
+    measure("legacy", input, [](int k) { return Legacy.toWrapper(k); });
+    measure("KeyMap", input, [](int k) { return inputmap::KeyMap::toWrapper(k); });
+    measure("paged", input, [](int k) { return PagedKeyMap::toWrapper(k); });
+    return 0;
+}
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include <cppwindow/cppwindow.hpp>
 
-#include <chrono>
 #include <cmath>
 #include <glad/glad.h>
 #include <iostream>
@@ -239,35 +238,32 @@ int main()
 
     Mat4 proj = mat4Perspective(45.f * 3.1415926f / 180.f, 1280.f / 720.f, 0.1f, 100.f);
 
-    using clock = std::chrono::steady_clock;
-
-    auto fpsTime = clock::now();
-    auto prevFrame = clock::now();
+    auto& pacer = window.getFramePacer();
+    pacer.setTargetRate(window.getRefreshRate());
 
     int frames = 0;
+    double fpsTime = 0.0;
     float time = 0.f;
     float cameraAngle = 0.f;
 
     while (!window.shouldClose()) {
-        auto now = clock::now();
-
         // delta time
-        std::chrono::duration<float> dt = now - prevFrame;
-        prevFrame = now;
-        float deltaTime = dt.count();
+        double dt = pacer.waitForNextFrame().count();
+        float deltaTime = static_cast<float>(dt);
         time += deltaTime;
         cameraAngle += 0.25f * deltaTime;
 
         // FPS counting
         frames++;
-        std::chrono::duration<double> fpsDelta = now - fpsTime;
+        fpsTime += dt;
 
-        if (fpsDelta.count() >= 1.0) {
-            double fps = frames / fpsDelta.count();
+        if (fpsTime >= 1.0) {
+            double fps = frames / fpsTime;
             frames = 0;
-            fpsTime = now;
+            fpsTime = 0.0;
 
-            std::cout << "OpenGL Heightmap | FPS: " << static_cast<int>(fps) << "\n";
+            std::cout << "OpenGL Heightmap | FPS: " << static_cast<int>(fps)
+                      << " | Missed: " << pacer.getMissedDeadlines() << "\n";
         }
 
         ctx.pollEvents();
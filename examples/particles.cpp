@@ -1,6 +1,5 @@
 #include <cppwindow/cppwindow.hpp>
 
-#include <chrono>
 #include <cmath>
 #include <glad/glad.h>
 #include <iostream>
@@ -208,14 +207,13 @@ int main()
     Mat4 view = mat4LookAt({ 0, 5, 8 }, { 0, 0, 0 }, { 0, 1, 0 });
     Mat4 mvp = mat4Multiply(proj, view);
 
-    auto lastTime = std::chrono::steady_clock::now();
+    // Cap the simulation to the monitor refresh rate
+    auto& pacer = window.getFramePacer();
+    pacer.setTargetRate(window.getRefreshRate());
 
     std::vector<float> buffer(NUM_PARTICLES * 3);
     while (!window.shouldClose()) {
-        auto now = std::chrono::steady_clock::now();
-        std::chrono::duration<float> dt = now - lastTime;
-        lastTime = now;
-        float deltaTime = dt.count();
+        float deltaTime = static_cast<float>(pacer.waitForNextFrame().count());
 
         ctx.pollEvents();
         for (auto& e : window.events()) {
@@ -6,12 +6,19 @@
 #ifndef CPPWINDOW_HEADER_CPPWINDOW_HPP
 #define CPPWINDOW_HEADER_CPPWINDOW_HPP
 
+#include <chrono>
+#include <exception>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <span>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <variant>
+#include <vector>
 
 namespace cwin {
 
@@ -23,6 +30,17 @@ using ProcLoader = ProcFunction (*)(const char*);
 // In Vulkan, handles are 64-bit integers.
 using VulkanHandle = uint64_t;
 
+// Identifies a live window. Ids of destroyed windows never match a later window.
+struct WindowId
+{
+    static constexpr uint32_t InvalidIndex = ~uint32_t{ 0 };
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool operator==(const WindowId&) const = default;
+};
+
 // Native Handles
 struct NativeHandles
 {
@@ -202,6 +220,59 @@ enum class MouseButton : uint8_t
     Last = Button8  // Count for MouseButton
 };
 
+enum class CursorShape : uint8_t
+{
+    Arrow,
+    IBeam,
+    Crosshair,
+    PointingHand,
+    ResizeEW,
+    ResizeNS,
+    ResizeNWSE,
+    ResizeNESW,
+    ResizeAll,
+    NotAllowed,
+    Last = NotAllowed
+};
+
+enum class CursorMode : uint8_t
+{
+    Normal,    //!< Visible and free to leave the window
+    Hidden,    //!< Invisible while over the content area
+    Captured,  //!< Visible but confined to the content area
+    Disabled   //!< Hidden and locked, for unbounded (camera) movement
+};
+
+// Custom cursor image, 8-bit RGBA rows top to bottom, not premultiplied
+struct CursorImage
+{
+    int width = 0;
+    int height = 0;
+    int hotX = 0;
+    int hotY = 0;
+    std::span<const uint8_t> pixels;
+};
+
+// Identifies a custom cursor created through the WindowContext
+using CursorHandle = uint32_t;
+
+// 8 bits per channel, 4 bytes per pixel
+enum class PixelFormat : uint8_t
+{
+    RGBA8,
+    BGRA8,
+    RGBA8Premultiplied,
+    BGRA8Premultiplied
+};
+
+struct IconImage
+{
+    int width = 0;
+    int height = 0;
+    PixelFormat format = PixelFormat::RGBA8;
+    std::span<const uint8_t> pixels;
+};
+
 //  The total number of keyboard keys, ignoring `Key::Unknown`
 inline constexpr unsigned int KeyCount{ static_cast<unsigned int>(Key::Last) };
 // The total number of mouse buttons, ignoring `MouseButton::Unknown`
@@ -242,6 +313,12 @@ public:
         int height;
     };
 
+    struct ContentScaleChanged
+    {
+        float scaleX;
+        float scaleY;
+    };
+
     struct FocusLost
     {};
 
@@ -363,10 +440,26 @@ public:
         // Vector3f value;
     };
 
+    struct ClipboardReceived
+    {
+        // points into the window's event storage, valid until the next
+        // pollEvents
+        std::string_view text;
+    };
+
+    struct FilesDropped
+    {
+        // valid until the next pollEvents
+        std::span<const std::string_view> paths;
+        double posX{};
+        double posY{};
+    };
+
     using Data = std::variant<
         FrameBufferResized,
         Closed,
         Resized,
+        ContentScaleChanged,
         FocusLost,
         FocusGained,
         TextEntered,
@@ -386,7 +479,9 @@ public:
         TouchBegan,
         TouchMoved,
         TouchEnded,
-        SensorChanged>;
+        SensorChanged,
+        ClipboardReceived,
+        FilesDropped>;
 
     Event() = default;
 
@@ -449,6 +544,11 @@ public:
     bool isKeyDown(Key key) const;
     bool isKeyPressed(Key key) const;
     bool isKeyReleased(Key key) const;
+    // Physical key state, independent of the keyboard layout. Scancodes are
+    // platform-specific, get them from Event::KeyPressed or WindowContext::getKeyScancode.
+    bool isScancodeDown(int scancode) const;
+    bool isScancodePressed(int scancode) const;
+    bool isScancodeReleased(int scancode) const;
 
     // mouse
     bool isMouseButtonDown(MouseButton button) const;
@@ -464,14 +564,111 @@ private:
 };
 
 //----------------------------------------------------------------------------
-//  Window
+//  Frame Pacer
+//----------------------------------------------------------------------------
+class FramePacer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // A target rate of zero (or less) leaves the frame rate uncapped
+    explicit FramePacer(double targetRate = 0.0) noexcept;
+
+    void setTargetRate(double rate) noexcept;
+    double getTargetRate() const noexcept;
+    void reset() noexcept;
+
+    // Sleeps until shortly before the next deadline, then spins until it is reached.
+    // Returns the time elapsed since the previous call.
+    std::chrono::duration<double> waitForNextFrame() noexcept;
+
+    Clock::duration getSleepMargin() const noexcept;
+    uint64_t getMissedDeadlines() const noexcept;
+    bool missedLastDeadline() const noexcept;
+
+private:
+    void calibrate(Clock::duration overshoot) noexcept;
+
+    Clock::duration period_{};
+    Clock::duration sleepMargin_{};
+    Clock::time_point deadline_{};
+    Clock::time_point lastFrame_{};
+    uint64_t missedDeadlines_ = 0;
+    bool missedLast_ = false;
+};
+
+//----------------------------------------------------------------------------
+//  Frame Statistics
 //----------------------------------------------------------------------------
+// Percentiles come from log-linear buckets (~12% wide) and report the upper
+// bound of the bucket they fall in, capped at `max`, so they never understate
+struct TimingPercentiles
+{
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    Duration p50{};
+    Duration p95{};
+    Duration p99{};
+    Duration max{};
+    uint32_t samples = 0;
+};
+
+struct FrameStats
+{
+    // time spent dispatching events per frame: one pollEvents, or every
+    // dispatchPending between two clearEvents (shared by all windows)
+    TimingPercentiles poll;
+    TimingPercentiles present;  // time between consecutive swapBuffers calls
+    TimingPercentiles swap;     // time swapBuffers blocked
+};
+
+//----------------------------------------------------------------------------
+//  Window Transaction
+//----------------------------------------------------------------------------
+struct WindowStateChange
+{
+    std::optional<std::string> title;
+    std::optional<std::pair<int, int>> size;
+    std::optional<std::pair<int, int>> position;
+    std::optional<bool> visible;
+    std::optional<bool> decorated;
+};
+
 class NativeWindow;
+
+class WindowTransaction final
+{
+    friend class Window;
+
+public:
+    WindowTransaction& title(std::string t);
+    WindowTransaction& size(int w, int h);
+    WindowTransaction& position(int x, int y);
+    WindowTransaction& visible(bool v);
+    WindowTransaction& decorated(bool d);
+    // Diffs against the window's cached state and applies only real changes
+    void commit();
+
+private:
+    explicit WindowTransaction(NativeWindow* window);
+
+    NativeWindow* window_;
+    WindowStateChange changes_{};
+};
+
+//----------------------------------------------------------------------------
+//  Window
+//----------------------------------------------------------------------------
 class WindowBuilder;
+class WindowPool;
+class RenderThread;
 
 class Window final
 {
     friend class WindowBuilder;
+    friend class WindowPool;
+    friend class RenderThread;
+    friend class WindowContext;
 
 public:
     ~Window();
@@ -482,8 +679,24 @@ public:
     Window& operator=(Window&&) = delete;
 
     NativeHandles getNativeHandles() const;
-    VulkanHandle createVulkanSurface(void* instance) const;
+    // `allocator` is an optional const VkAllocationCallbacks*,
+    // throws GLFWException on failure
+    VulkanHandle createVulkanSurface(void* instance, const void* allocator = nullptr) const;
+    // For lost or out-of-date surfaces: destroys `surface` if set and creates
+    // a new one in its place. Returns the VkResult, `surface` is 0 if creation
+    // failed. VK_ERROR_INITIALIZATION_FAILED (-3) with `surface` untouched if
+    // vkDestroySurfaceKHR can't be resolved.
+    int32_t recreateVulkanSurface(
+        void* instance,
+        VulkanHandle& surface,
+        const void* allocator = nullptr) const noexcept;
     void makeContextCurrent();
+    // Bind the OpenGL context to the calling thread,
+    // throws std::logic_error if another thread still holds it
+    void attachContext();
+    // Release the OpenGL context from the calling thread
+    void detachContext();
+    bool isContextCurrent() const noexcept;
     void swapBuffers();
 
     bool shouldClose() const noexcept;
@@ -491,21 +704,79 @@ public:
 
     std::span<Event> events() const noexcept;
     const InputState& getInput() const noexcept;
-
+    // All characters entered since the last pollEvents, in order. The same
+    // characters are also delivered one by one as Event::TextEntered.
+    std::u32string_view getTextInput() const noexcept;
+    // getTextInput() as UTF-8, transcoded on first use each frame
+    std::string_view getTextInputUtf8() const;
+
+    // Candidate icon sizes, the platform picks the closest match. Converted
+    // images are cached by content, re-applying the same set is a lookup.
+    void setIcon(std::span<const IconImage> images);
+
+    // Batch several state changes, e.g. window.update().title("x").size(w, h).commit()
+    WindowTransaction update();
     void setTitle(const std::string& title);
     void setSize(int width, int height);
     void setFocus(bool focus) const noexcept;
     void setVisible(bool visible) const noexcept;
     std::pair<int, int> getSize() const noexcept;
     std::pair<uint32_t, uint32_t> getFrameBufferSize() const noexcept;
+    // Cached, updated whenever Event::ContentScaleChanged is delivered
+    std::pair<float, float> getContentScale() const noexcept;
+    // Surface tracking for swapchain recreation, the latest framebuffer extent
+    // is kept and the generation increases each time it changes
+    bool isSurfaceDirty() const noexcept;
+    uint64_t getSurfaceGeneration() const noexcept;
+    // Returns the latest framebuffer extent and clears the dirty flag
+    std::pair<uint32_t, uint32_t> acknowledgeSurface() noexcept;
+    // Deliver at most one Resized and one FrameBufferResized per poll
+    void setResizeCoalescing(bool enabled) noexcept;
     bool isFocused() const noexcept;
     bool isVisible() const noexcept;
 
+    // Refresh rate of the monitor the window is presented on, in Hz
+    double getRefreshRate() const noexcept;
+    FramePacer& getFramePacer() noexcept;
+    // Rolling statistics over the most recent frames, safe to read from any
+    // thread while another one swaps buffers
+    FrameStats getFrameStats() const noexcept;
+    void resetFrameStats() noexcept;
+
+    WindowId getId() const noexcept;
+
+    // True when both windows belong to the same OpenGL share group
+    bool sharesContextWith(const Window& other) const noexcept;
+
+    // Cursor changes are skipped when nothing differs from the current state
+    void setCursor(CursorShape shape);
+    void setCursor(CursorHandle cursor);
+    void setCursorMode(CursorMode mode);
+    CursorMode getCursorMode() const noexcept;
+
+    // Clipboard reads are synchronous: on X11 a read blocks until the
+    // selection owner answers. Contents are cached for a short time (and
+    // until one of our windows regains focus) so repeated reads in a frame
+    // cost one transfer. Returned views stay valid until the next pollEvents
+    // or clipboard write.
+    void setClipboard(std::string_view text);
+    // Blocks on a cache miss
+    std::string_view getClipboard();
+    // Delivers Event::ClipboardReceived on the next pollEvents. The read still
+    // blocks there, but happens once for every window that asked in the frame
+    // and always fetches the current contents.
+    void requestClipboard();
+
+    // Queue a synthetic event as if it came from the platform, it is
+    // delivered through events() and applied to the input state.
+    void injectEvent(const Event& event);
+
 private:
     explicit Window(std::unique_ptr<NativeWindow> window);
 
     InputState inputState_;
     std::unique_ptr<NativeWindow> window_;
+    FramePacer framePacer_;
 };
 
 //----------------------------------------------------------------------------
@@ -516,6 +787,8 @@ class WindowBuilder
 public:
     WindowBuilder();
     ~WindowBuilder();
+    WindowBuilder(WindowBuilder&&) noexcept;
+    WindowBuilder& operator=(WindowBuilder&&) noexcept;
 
     WindowBuilder& title(std::string t);
     WindowBuilder& size(int w, int h);
@@ -524,6 +797,16 @@ public:
     WindowBuilder& hidden();
     WindowBuilder& resizable();
     WindowBuilder& borderless();
+    // Resize the window by the content scale of its monitor (GLFW_SCALE_TO_MONITOR)
+    WindowBuilder& scaleToMonitor();
+    // Framebuffer at native pixel density (GLFW_SCALE_FRAMEBUFFER, on by default)
+    WindowBuilder& scaleFramebuffer(bool enabled);
+    // See Window::setResizeCoalescing
+    WindowBuilder& coalesceResizeEvents();
+    // Join the OpenGL share group of `window`, textures, buffers and other
+    // shareable GL objects become visible to both contexts.
+    // Both windows should use the same OpenGL version and profile.
+    WindowBuilder& shareContextWith(const Window& window);
     Window build();
 
 private:
@@ -531,28 +814,186 @@ private:
     std::unique_ptr<Data> data_{};
 };
 
+//----------------------------------------------------------------------------
+//  Render Thread
+//----------------------------------------------------------------------------
+class RenderThread final
+{
+public:
+    // Moves the window's OpenGL context from the calling thread to a new thread
+    // running `render`, the calling thread is free to keep pumping events.
+    // The window must outlive the render thread.
+    RenderThread(Window& window, std::function<void(std::stop_token)> render);
+    // Requests stop and joins
+    ~RenderThread();
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    void requestStop() noexcept;
+    // Waits for `render` to return, the context is left detached and can be
+    // attached again by the caller. Rethrows any exception thrown by `render`.
+    void join();
+    bool joinable() const noexcept;
+
+private:
+    std::jthread thread_;
+    std::exception_ptr error_;
+};
+
+//----------------------------------------------------------------------------
+//  Window Pool
+//----------------------------------------------------------------------------
+class WindowPool final
+{
+public:
+    // Builds `count` hidden windows from `prototype` up front
+    WindowPool(WindowBuilder prototype, size_t count);
+    ~WindowPool();
+    WindowPool(WindowPool&&) noexcept;
+    WindowPool& operator=(WindowPool&&) noexcept;
+
+    // Hands out a pooled window retitled, resized and shown.
+    // Builds a new window from the prototype when the pool is empty.
+    Window acquire(const std::string& title, int width, int height);
+    // Hides the window and keeps it for the next acquire(). Throws
+    // std::invalid_argument, leaving `window` untouched, if this pool did
+    // not build it.
+    void release(Window&& window);
+
+    size_t available() const noexcept;
+
+private:
+    Window build();
+
+    WindowBuilder prototype_;
+    std::vector<Window> windows_;
+    // every window this pool built, whether pooled or handed out
+    std::vector<WindowId> members_;
+};
+
 //----------------------------------------------------------------------------
 //  Window Context
 //----------------------------------------------------------------------------
 class NativeWindowContext;
 
+struct ContextOptions
+{
+    enum class Platform : uint8_t
+    {
+        // let the backend pick the best available one
+        Any,
+        Win32,
+        Cocoa,
+        Wayland,
+        X11,
+        Null
+    };
+
+    Platform platform = Platform::Any;
+    // Run without a display server (GLFW Null platform). Windows, events and
+    // input state keep working, events can be fed through Window::injectEvent.
+    // Shorthand for platform = Platform::Null.
+    bool headless = false;
+
+    // Init hints, ignored on platforms they do not apply to
+    // Report joystick hats as buttons as well as hats
+    bool joystickHatButtons = true;
+    // Create Vulkan surfaces through XCB instead of Xlib on X11
+    bool x11XcbVulkanSurface = true;
+    // Use libdecor for window decorations on Wayland when available
+    bool waylandLibdecor = true;
+    // Change the working directory to the bundle's Resources on macOS
+    bool cocoaChdirResources = true;
+    // Create a basic menu bar on macOS
+    bool cocoaMenubar = true;
+};
+
 class WindowContext final
 {
 public:
+    // Create the context with explicit options, must be called before Get()
+    static WindowContext& initialize(const ContextOptions& options = {});
+    // Returns the context, initializing it with default options if needed
     static WindowContext& Get();
 
     ~WindowContext();
     WindowContext(const WindowContext&) = delete;
     WindowContext& operator=(const WindowContext&) = delete;
 
+    // clearEvents() followed by dispatchPending(), once per frame
     void pollEvents() const noexcept;
+    // Processes events that are already pending without blocking. Events are
+    // appended to what windows already hold, so this can run whenever the
+    // event file descriptor becomes readable.
+    void dispatchPending() const noexcept;
+    // Drops the events of the last frame and rotates input state, call after
+    // the events delivered through dispatchPending have been consumed
+    void clearEvents() const noexcept;
+    // Display connection to wait on in an external poll/epoll loop: the X11
+    // or Wayland socket, -1 on platforms without one (Win32, Cocoa, Null).
+    // Call dispatchPending when it is readable and once before waiting.
+    // Wayland key repeat runs on GLFW's own timers, not on this descriptor.
+    int getEventFileDescriptor() const noexcept;
+    // Windows that received events since the previous clearEvents, each once,
+    // valid until the next clearEvents
+    std::span<const WindowId> getWindowsWithEvents() const noexcept;
+    bool isHeadless() const noexcept;
+    // The platform actually selected, never Platform::Any
+    ContextOptions::Platform getPlatform() const noexcept;
+    // Time spent in backend initialization
+    std::chrono::nanoseconds getInitDuration() const noexcept;
+
+    WindowPool createWindowPool(WindowBuilder prototype, size_t count) const;
+
+    // Window mutations that may be posted from any thread. They are applied on
+    // the main thread at the start of the next pollEvents, only the last
+    // command of each kind per window survives. The window must stay alive
+    // until the call returns, commands for windows destroyed meanwhile are dropped.
+    void postSetTitle(const Window& window, std::string title);
+    void postSetSize(const Window& window, int width, int height);
+    void postSetVisible(const Window& window, bool visible);
+
+    // Layout-aware key names from a table that is rebuilt only after the
+    // keyboard layout may have changed: when a window regains focus, or when
+    // a poll finds that a few probe letters (Q, W, Y) are named differently,
+    // which catches switches between layouts that move letters or change
+    // script. Names are empty for keys the platform does not name, such as
+    // most non-printable keys. Views stay valid until the table is rebuilt,
+    // copy them to keep them longer. Main thread only.
+    std::string_view getKeyName(Key key) const;
+    std::string_view getScancodeName(int scancode) const;
+    // Platform scancode of `key`, -1 if it has none
+    int getKeyScancode(Key key) const;
+
+    // Registers an SDL-format gamepad mapping file (e.g. the community
+    // gamecontrollerdb.txt). The file is memory-mapped and indexed on first
+    // need, only entries for this platform and for joysticks that are or
+    // become connected are handed to GLFW. Later files override earlier ones.
+    // Throws std::runtime_error if the file cannot be mapped.
+    void loadGamepadMappings(const std::filesystem::path& path);
+
+    // Cursors are created once and live as long as the context
+    CursorHandle createCursor(const CursorImage& image);
 
     ProcLoader getProcLoader() const;
     bool isVulkanSupported() const;
+    // Whether a queue family of `physicalDevice` (a VkPhysicalDevice) can
+    // present to windows on this platform, no window needs to exist yet
+    bool isPresentationSupported(void* instance, void* physicalDevice, uint32_t queueFamily)
+        const noexcept;
     std::vector<std::string> getRequiredGlfwVulkanExtensions() const;
+    // Instance extensions required for window surfaces, backed by storage
+    // owned by the backend and valid while the context lives
+    std::span<const char* const> getRequiredVulkanInstanceExtensions() const;
+    // Writes the required extensions followed by every entry of `requested`
+    // not already present into `out` and returns the number written.
+    // Throws std::out_of_range if `out` is too small.
+    size_t mergeVulkanExtensions(
+        std::span<const char* const> requested,
+        std::span<const char*> out) const;
 
 private:
-    WindowContext();
+    explicit WindowContext(const ContextOptions& options);
 
     std::unique_ptr<NativeWindowContext> context_{};
 };
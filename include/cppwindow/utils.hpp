@@ -7,6 +7,8 @@
 #define CPPWINDOW_HEADER_UTILS_HPP
 
 #include <array>
+#include <concepts>
+#include <cstdint>
 #include <memory>
 
 namespace cwin {
@@ -42,72 +44,189 @@ concept StaticLookupTraits = requires {
 };
 
 template <StaticLookupTraits Traits>
-struct StaticLookup
+struct StaticLookupEntry
 {
+    typename Traits::WrapperType wrapperVal;
+    typename Traits::BackendType backendVal;
+};
+
+// Two-way mapping between a dense wrapper enum and backend constants, built
+// and validated at compile time from `Entries`, a constexpr array of
+// StaticLookupEntry<Traits>. Wrapper -> backend is a single dense array.
+// Backend -> wrapper is dense as well unless the backend range is sparse
+// enough that a page directory, storing only pages that contain an entry,
+// saves at least Traits::PagingMinSavings bytes (DefaultPagingMinSavings if
+// the traits don't say). The directory costs an extra dependent load per
+// lookup. Values outside a range map to the None value.
+inline constexpr size_t DefaultPagingMinSavings = 1024;
+
+template <StaticLookupTraits Traits, const auto& Entries>
+class StaticLookup
+{
+public:
     using WrapperType = typename Traits::WrapperType;
     using BackendType = typename Traits::BackendType;
 
+private:
     static constexpr size_t WrapperMinVal = static_cast<size_t>(Traits::WrapperFirst);
-    static constexpr size_t WrapperMaxVal = static_cast<size_t>(Traits::WrapperLast);
-    static constexpr size_t WrapperCount = (WrapperMaxVal - WrapperMinVal + 1);
+    static constexpr size_t WrapperCount =
+        static_cast<size_t>(Traits::WrapperLast) - WrapperMinVal + 1;
 
     static constexpr size_t BackendMinVal = static_cast<size_t>(Traits::BackendFirst);
-    static constexpr size_t BackendMaxVal = static_cast<size_t>(Traits::BackendLast);
-    static constexpr size_t BackendCount = (BackendMaxVal - BackendMinVal + 1);
+    static constexpr size_t BackendCount =
+        static_cast<size_t>(Traits::BackendLast) - BackendMinVal + 1;
 
-    // Mapper -> Backend
-    std::array<BackendType, WrapperCount> toBackendMap;
-    // Backend -> Mapper
-    std::array<WrapperType, BackendCount> toWrapperMap;
+    // 32 entries per page
+    static constexpr size_t PageBits = 5;
+    static constexpr size_t PageSize = size_t{ 1 } << PageBits;
+    static constexpr size_t DirectorySize = (BackendCount + PageSize - 1) / PageSize;
 
-    struct Entry
+    // unsigned wrap-around turns values below the first one into huge
+    // indices, so a single comparison covers both ends of the range
+    static constexpr size_t wrapperIndex(WrapperType w) noexcept
     {
-        WrapperType wrapperVal;
-        BackendType backendVal;
-    };
+        return static_cast<size_t>(w) - WrapperMinVal;
+    }
+
+    static constexpr size_t backendIndex(BackendType b) noexcept
+    {
+        return static_cast<size_t>(b) - BackendMinVal;
+    }
 
-    template <size_t N>
-    constexpr StaticLookup(const Entry (&mapping)[N])
-        : toBackendMap{},
-          toWrapperMap{}
+    static constexpr bool entriesInRange()
     {
-        toWrapperMap.fill(Traits::WrapperNone);
-        toBackendMap.fill(Traits::BackendNone);
-        for (int i = 0; i < N; i++) {
-            addEntry(mapping[i]);
+        for (const auto& entry : Entries) {
+            if (wrapperIndex(entry.wrapperVal) >= WrapperCount
+                || backendIndex(entry.backendVal) >= BackendCount) {
+                return false;
+            }
         }
-        //(..., addEntry<mapping>());
+        return true;
     }
 
-    constexpr void addEntry(const Entry& entry)
+    static constexpr bool entriesBijective()
     {
-        size_t wIdx = static_cast<size_t>(entry.wrapperVal) - WrapperMinVal;
-        // static_assert(wIdx < WrapperMaxVal, "Wrapper out of range");
-        toBackendMap[wIdx] = entry.backendVal;
+        std::array<bool, WrapperCount> wrapperSeen{};
+        std::array<bool, BackendCount> backendSeen{};
+        for (const auto& entry : Entries) {
+            if (entry.wrapperVal == Traits::WrapperNone
+                || entry.backendVal == Traits::BackendNone) {
+                return false;
+            }
+            bool& wrapper = wrapperSeen[wrapperIndex(entry.wrapperVal)];
+            bool& backend = backendSeen[backendIndex(entry.backendVal)];
+            if (wrapper || backend) {
+                return false;
+            }
+            wrapper = backend = true;
+        }
+        return true;
+    }
+
+    static_assert(entriesInRange(), "StaticLookup entry outside the traits' First/Last range");
+    static_assert(entriesBijective(), "StaticLookup entries must map one-to-one, without None");
+
+    static constexpr size_t countPages()
+    {
+        std::array<bool, DirectorySize> used{};
+        size_t count = 0;
+        for (const auto& entry : Entries) {
+            bool& page = used[backendIndex(entry.backendVal) >> PageBits];
+            count += page ? 0 : 1;
+            page = true;
+        }
+        return count;
+    }
+
+    // page 0 is all None and shared by every empty range
+    static constexpr size_t PageCount = countPages() + 1;
 
-        size_t bIdx = static_cast<size_t>(entry.backendVal) - BackendMinVal;
-        // static_assert(bIdx < BackendMaxVal, "Backend out of range");
-        toWrapperMap[bIdx] = entry.wrapperVal;
+    static constexpr size_t pagingMinSavings()
+    {
+        if constexpr (requires { Traits::PagingMinSavings; }) {
+            return Traits::PagingMinSavings;
+        } else {
+            return DefaultPagingMinSavings;
+        }
     }
 
-    // Two-way Keyboard
-    inline BackendType toBackend(WrapperType k) const noexcept
+    static constexpr size_t DenseBytes = BackendCount * sizeof(WrapperType);
+    static constexpr size_t PagedBytes = DirectorySize + PageCount * PageSize * sizeof(WrapperType);
+
+public:
+    // an 8-bit directory addresses at most 255 pages
+    static constexpr bool IsPaged =
+        PageCount <= UINT8_MAX && PagedBytes + pagingMinSavings() <= DenseBytes;
+
+private:
+    struct PagedTable
+    {
+        std::array<uint8_t, DirectorySize> directory{};
+        std::array<std::array<WrapperType, PageSize>, PageCount> pages{};
+    };
+    using DenseTable = std::array<WrapperType, BackendCount>;
+
+    static constexpr auto ToBackendMap = [] {
+        std::array<BackendType, WrapperCount> map{};
+        map.fill(Traits::BackendNone);
+        for (const auto& entry : Entries) {
+            map[wrapperIndex(entry.wrapperVal)] = entry.backendVal;
+        }
+        return map;
+    }();
+
+    static constexpr auto ToWrapperTable = [] {
+        if constexpr (IsPaged) {
+            PagedTable table{};
+            for (auto& page : table.pages) {
+                page.fill(Traits::WrapperNone);
+            }
+            uint8_t nextPage = 1;
+            for (const auto& entry : Entries) {
+                size_t idx = backendIndex(entry.backendVal);
+                uint8_t& page = table.directory[idx >> PageBits];
+                if (page == 0) {
+                    page = nextPage++;
+                }
+                table.pages[page][idx & (PageSize - 1)] = entry.wrapperVal;
+            }
+            return table;
+        } else {
+            DenseTable table{};
+            table.fill(Traits::WrapperNone);
+            for (const auto& entry : Entries) {
+                table[backendIndex(entry.backendVal)] = entry.wrapperVal;
+            }
+            return table;
+        }
+    }();
+
+public:
+    static constexpr BackendType toBackend(WrapperType w) noexcept
     {
-        size_t idx = static_cast<size_t>(k) - WrapperMinVal;
-        if (idx < 0 || idx > WrapperMaxVal) {
+        size_t idx = wrapperIndex(w);
+        if (idx >= WrapperCount) {
             return Traits::BackendNone;
         }
-        return toBackendMap[idx];
+        return ToBackendMap[idx];
     }
 
-    inline WrapperType toWrapper(BackendType k) const noexcept
+    static constexpr WrapperType toWrapper(BackendType b) noexcept
     {
-        size_t idx = static_cast<size_t>(k) - BackendMinVal;
-        if (idx < 0 || idx > BackendMaxVal) {
+        size_t idx = backendIndex(b);
+        if (idx >= BackendCount) {
             return Traits::WrapperNone;
         }
-        return toWrapperMap[k];
+        if constexpr (IsPaged) {
+            uint8_t page = ToWrapperTable.directory[idx >> PageBits];
+            return ToWrapperTable.pages[page][idx & (PageSize - 1)];
+        } else {
+            return ToWrapperTable[idx];
+        }
     }
+
+    // backend -> wrapper table footprint
+    static constexpr size_t TableBytes = sizeof(ToWrapperTable);
 };
 
 }  // namespace cwin
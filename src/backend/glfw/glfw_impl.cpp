@@ -6,6 +6,9 @@
 
 #include "glfw_impl.hpp"
 
+#include "../../pixel_convert.hpp"
+#include "../../utf_transcode.hpp"
+
 #if defined(CPPWINDOW_PLATFORM_WINDOWS)
 #define GLFW_EXPOSE_NATIVE_WIN32
 #define GLFW_EXPOSE_NATIVE_WGL
@@ -21,199 +24,73 @@
 #endif
 #include <GLFW/glfw3native.h>
 
+#if defined(CPPWINDOW_PLATFORM_LINUX)
+#include <dlfcn.h>
+// X.h names a shape constant CursorShape, which would rewrite cwin::CursorShape
+#undef CursorShape
+#endif
+
 // Manually forward declare the Vulkan types GLFW needs
 // This prevents needing <vulkan.h> entirely.
 typedef struct VkInstance_T* VkInstance;
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
 typedef uint64_t VkSurfaceKHR;
 typedef int VkResult;
+// Vulkan entry points use stdcall on 32-bit Windows (VKAPI_PTR)
+#if defined(_WIN32)
+#define CPPWINDOW_VKAPI_PTR __stdcall
+#else
+#define CPPWINDOW_VKAPI_PTR
+#endif
+typedef void(CPPWINDOW_VKAPI_PTR* PFN_vkDestroySurfaceKHR)(VkInstance, VkSurfaceKHR, const void*);
+constexpr VkResult VK_ERROR_INITIALIZATION_FAILED = -3;
+
+// glGetString, used to tell drivers apart in the proc table cache (APIENTRY)
+#if defined(_WIN32)
+#define CPPWINDOW_GLAPI_PTR __stdcall
+#else
+#define CPPWINDOW_GLAPI_PTR
+#endif
+typedef const unsigned char*(CPPWINDOW_GLAPI_PTR* PFN_glGetString)(unsigned int);
 
-// Tell the compiler that this function exists externally (it's in the GLFW lib)
+// Tell the compiler that these functions exist externally (they're in the GLFW lib)
 extern "C" VkResult glfwCreateWindowSurface(
     VkInstance instance,
     GLFWwindow* window,
     const void* allocator,
     VkSurfaceKHR* surface);
+extern "C" int glfwGetPhysicalDevicePresentationSupport(
+    VkInstance instance,
+    VkPhysicalDevice device,
+    uint32_t queuefamily);
+extern "C" GLFWvkproc glfwGetInstanceProcAddress(VkInstance instance, const char* procname);
 
 namespace cwin {
 
 //----------------------------------------------------------------------------
 //  GLFW Input Mapping Implementation
 //----------------------------------------------------------------------------
-namespace {
-
-static constexpr KeyMapLookup KeyMap(
-    {
-        /* Printable keys */
-        { Key::Space, GLFW_KEY_SPACE },
-        { Key::Apostrophe, GLFW_KEY_APOSTROPHE },
-        { Key::Comma, GLFW_KEY_COMMA },
-        { Key::Minus, GLFW_KEY_MINUS },
-        { Key::Period, GLFW_KEY_PERIOD },
-        { Key::Slash, GLFW_KEY_SLASH },
-
-        { Key::Num0, GLFW_KEY_0 },
-        { Key::Num1, GLFW_KEY_1 },
-        { Key::Num2, GLFW_KEY_2 },
-        { Key::Num3, GLFW_KEY_3 },
-        { Key::Num4, GLFW_KEY_4 },
-        { Key::Num5, GLFW_KEY_5 },
-        { Key::Num6, GLFW_KEY_6 },
-        { Key::Num7, GLFW_KEY_7 },
-        { Key::Num8, GLFW_KEY_8 },
-        { Key::Num9, GLFW_KEY_9 },
-
-        { Key::Semicolon, GLFW_KEY_SEMICOLON },
-        { Key::Equal, GLFW_KEY_EQUAL },
-
-        { Key::A, GLFW_KEY_A },
-        { Key::B, GLFW_KEY_B },
-        { Key::C, GLFW_KEY_C },
-        { Key::D, GLFW_KEY_D },
-        { Key::E, GLFW_KEY_E },
-        { Key::F, GLFW_KEY_F },
-        { Key::G, GLFW_KEY_G },
-        { Key::H, GLFW_KEY_H },
-        { Key::I, GLFW_KEY_I },
-        { Key::J, GLFW_KEY_J },
-        { Key::K, GLFW_KEY_K },
-        { Key::L, GLFW_KEY_L },
-        { Key::M, GLFW_KEY_M },
-        { Key::N, GLFW_KEY_N },
-        { Key::O, GLFW_KEY_O },
-        { Key::P, GLFW_KEY_P },
-        { Key::Q, GLFW_KEY_Q },
-        { Key::R, GLFW_KEY_R },
-        { Key::S, GLFW_KEY_S },
-        { Key::T, GLFW_KEY_T },
-        { Key::U, GLFW_KEY_U },
-        { Key::V, GLFW_KEY_V },
-        { Key::W, GLFW_KEY_W },
-        { Key::X, GLFW_KEY_X },
-        { Key::Y, GLFW_KEY_Y },
-        { Key::Z, GLFW_KEY_Z },
-
-        { Key::LBracket, GLFW_KEY_LEFT_BRACKET },
-        { Key::Backslash, GLFW_KEY_BACKSLASH },
-        { Key::RBracket, GLFW_KEY_RIGHT_BRACKET },
-        { Key::Grave, GLFW_KEY_GRAVE_ACCENT },
-        { Key::World1, GLFW_KEY_WORLD_1 },
-        { Key::World2, GLFW_KEY_WORLD_2 },
-
-        /* Function keys */
-        { Key::Escape, GLFW_KEY_ESCAPE },
-        { Key::Enter, GLFW_KEY_ENTER },
-        { Key::Tab, GLFW_KEY_TAB },
-        { Key::Backspace, GLFW_KEY_BACKSPACE },
-        { Key::Insert, GLFW_KEY_INSERT },
-        { Key::Delete, GLFW_KEY_DELETE },
-
-        { Key::Right, GLFW_KEY_RIGHT },
-        { Key::Left, GLFW_KEY_LEFT },
-        { Key::Down, GLFW_KEY_DOWN },
-        { Key::Up, GLFW_KEY_UP },
-
-        { Key::PageUp, GLFW_KEY_PAGE_UP },
-        { Key::PageDown, GLFW_KEY_PAGE_DOWN },
-        { Key::Home, GLFW_KEY_HOME },
-        { Key::End, GLFW_KEY_END },
-        { Key::CapsLock, GLFW_KEY_CAPS_LOCK },
-        { Key::ScrollLock, GLFW_KEY_SCROLL_LOCK },
-        { Key::NumLock, GLFW_KEY_NUM_LOCK },
-        { Key::PrintScreen, GLFW_KEY_PRINT_SCREEN },
-        { Key::Pause, GLFW_KEY_PAUSE },
-
-        /* Function keys */
-        { Key::F1, GLFW_KEY_F1 },
-        { Key::F2, GLFW_KEY_F2 },
-        { Key::F3, GLFW_KEY_F3 },
-        { Key::F4, GLFW_KEY_F4 },
-        { Key::F5, GLFW_KEY_F5 },
-        { Key::F6, GLFW_KEY_F6 },
-        { Key::F7, GLFW_KEY_F7 },
-        { Key::F8, GLFW_KEY_F8 },
-        { Key::F9, GLFW_KEY_F9 },
-        { Key::F10, GLFW_KEY_F10 },
-        { Key::F11, GLFW_KEY_F11 },
-        { Key::F12, GLFW_KEY_F12 },
-        { Key::F13, GLFW_KEY_F13 },
-        { Key::F14, GLFW_KEY_F14 },
-        { Key::F15, GLFW_KEY_F15 },
-        { Key::F16, GLFW_KEY_F16 },
-        { Key::F17, GLFW_KEY_F17 },
-        { Key::F18, GLFW_KEY_F18 },
-        { Key::F19, GLFW_KEY_F19 },
-        { Key::F20, GLFW_KEY_F20 },
-        { Key::F21, GLFW_KEY_F21 },
-        { Key::F22, GLFW_KEY_F22 },
-        { Key::F23, GLFW_KEY_F23 },
-        { Key::F24, GLFW_KEY_F24 },
-        { Key::F25, GLFW_KEY_F25 },
-
-        /* Numpad Keys */
-        { Key::Numpad0, GLFW_KEY_KP_0 },
-        { Key::Numpad1, GLFW_KEY_KP_1 },
-        { Key::Numpad2, GLFW_KEY_KP_2 },
-        { Key::Numpad3, GLFW_KEY_KP_3 },
-        { Key::Numpad4, GLFW_KEY_KP_4 },
-        { Key::Numpad5, GLFW_KEY_KP_5 },
-        { Key::Numpad6, GLFW_KEY_KP_6 },
-        { Key::Numpad7, GLFW_KEY_KP_7 },
-        { Key::Numpad8, GLFW_KEY_KP_8 },
-        { Key::Numpad9, GLFW_KEY_KP_9 },
-        { Key::NumpadDecimal, GLFW_KEY_KP_DECIMAL },
-        { Key::NumpadDivide, GLFW_KEY_KP_DIVIDE },
-        { Key::NumpadMultiply, GLFW_KEY_KP_MULTIPLY },
-        { Key::NumpadSubtract, GLFW_KEY_KP_SUBTRACT },
-        { Key::NumpadAdd, GLFW_KEY_KP_ADD },
-        { Key::NumpadEnter, GLFW_KEY_KP_ENTER },
-        { Key::NumpadEqual, GLFW_KEY_KP_EQUAL },
-
-        { Key::LShift, GLFW_KEY_LEFT_SHIFT },
-        { Key::LControl, GLFW_KEY_LEFT_CONTROL },
-        { Key::LAlt, GLFW_KEY_LEFT_ALT },
-        { Key::LSuper, GLFW_KEY_LEFT_SUPER },
-        { Key::RShift, GLFW_KEY_RIGHT_SHIFT },
-        { Key::RControl, GLFW_KEY_RIGHT_CONTROL },
-        { Key::RAlt, GLFW_KEY_RIGHT_ALT },
-        { Key::RSuper, GLFW_KEY_RIGHT_SUPER },
-        { Key::Menu, GLFW_KEY_MENU },
-    });
-
-static constexpr MouseMapLookup MouseMap(
-    {
-        { MouseButton::Left, GLFW_MOUSE_BUTTON_LEFT },
-        { MouseButton::Right, GLFW_MOUSE_BUTTON_RIGHT },
-        { MouseButton::Middle, GLFW_MOUSE_BUTTON_MIDDLE },
-        { MouseButton::Button4, GLFW_MOUSE_BUTTON_4 },
-        { MouseButton::Button5, GLFW_MOUSE_BUTTON_5 },
-        { MouseButton::Button6, GLFW_MOUSE_BUTTON_6 },
-        { MouseButton::Button7, GLFW_MOUSE_BUTTON_7 },
-        { MouseButton::Button8, GLFW_MOUSE_BUTTON_8 },
-    });
-
-}  // namespace
-
 namespace inputmap {
 
 int toGlfwKey(Key k)
 {
-    return KeyMap.toBackend(k);
+    return KeyMap::toBackend(k);
 }
 
 Key toKey(int k)
 {
-    return KeyMap.toWrapper(k);
+    return KeyMap::toWrapper(k);
 }
 
 // Two-way Mouse
 int toGlfwMouseButton(MouseButton b)
 {
-    return MouseMap.toBackend(b);
+    return MouseMap::toBackend(b);
 }
 
 MouseButton toMouseButton(int b)
 {
-    return MouseMap.toWrapper(b);
+    return MouseMap::toWrapper(b);
 }
 
 }  // namespace inputmap
@@ -226,10 +103,22 @@ void GLFWInputState::handleEvent(const Event& event)
 {
     event.visit([&](auto&& event) {
         using T = std::decay_t<decltype(event)>;
+        // unmapped keys would all share the Key::Unknown bit, only their
+        // scancodes are tracked
         if constexpr (std::is_same_v<T, Event::KeyPressed>) {
-            keyStates_.set(static_cast<size_t>(event.key));
+            if (event.key != Key::Unknown) {
+                keyStates_.set(static_cast<size_t>(event.key));
+            }
+            if (static_cast<size_t>(event.scancode) < ScancodeCount) {
+                scancodeStates_.set(static_cast<size_t>(event.scancode));
+            }
         } else if constexpr (std::is_same_v<T, Event::KeyReleased>) {
-            keyStates_.reset(static_cast<size_t>(event.key));
+            if (event.key != Key::Unknown) {
+                keyStates_.reset(static_cast<size_t>(event.key));
+            }
+            if (static_cast<size_t>(event.scancode) < ScancodeCount) {
+                scancodeStates_.reset(static_cast<size_t>(event.scancode));
+            }
         } else if constexpr (std::is_same_v<T, Event::MouseButtonPressed>) {
             mouseStates_.set(static_cast<size_t>(event.button));
         } else if constexpr (std::is_same_v<T, Event::MouseButtonReleased>) {
@@ -242,6 +131,7 @@ void GLFWInputState::handleEvent(const Event& event)
             mousePosY_ = event.posY;
         } else if constexpr (std::is_same_v<T, Event::FocusLost>) {
             keyStates_.reset();
+            scancodeStates_.reset();
             mouseStates_.reset();
         }
     });
@@ -264,6 +154,24 @@ bool GLFWInputState::isKeyReleased(Key key) const
     return !keyStates_.test(idx) && prevKeyStates_.test(idx);
 }
 
+bool GLFWInputState::isScancodeDown(int scancode) const
+{
+    size_t idx = static_cast<size_t>(scancode);
+    return idx < ScancodeCount && scancodeStates_.test(idx);
+}
+
+bool GLFWInputState::isScancodePressed(int scancode) const
+{
+    size_t idx = static_cast<size_t>(scancode);
+    return idx < ScancodeCount && scancodeStates_.test(idx) && !prevScancodeStates_.test(idx);
+}
+
+bool GLFWInputState::isScancodeReleased(int scancode) const
+{
+    size_t idx = static_cast<size_t>(scancode);
+    return idx < ScancodeCount && !scancodeStates_.test(idx) && prevScancodeStates_.test(idx);
+}
+
 bool GLFWInputState::isMouseButtonDown(MouseButton button) const
 {
     return mouseStates_.test(static_cast<size_t>(button));
@@ -294,22 +202,522 @@ std::pair<double, double> GLFWInputState::getScrollDelta() const
 void GLFWInputState::reset()
 {
     prevKeyStates_ = keyStates_;
+    prevScancodeStates_ = scancodeStates_;
     prevMouseStates_ = mouseStates_;
     scrollDeltaX_ = 0;
     scrollDeltaY_ = 0;
 }
 
+void GLFWInputState::clear()
+{
+    *this = GLFWInputState{};
+}
+
 //----------------------------------------------------------------------------
 //  GLFW Window Registry Implementation
 //----------------------------------------------------------------------------
 namespace {
 
-// store all refs to windows storage so we can clean it
-// per frame
+// per-window event storage, reset every frame
 WindowStorageRegistry<WindowStorage> g_WindowRegistry;
 
+// pollEvents services every window at once, so its timings are shared
+TimingHistogram g_PollTimings;
+
+// caches owned by the live context, null before and after it
+GLFWSharedCaches* g_Caches = nullptr;
+
+// clipboard cache and pending asynchronous reads
+GLFWClipboard g_Clipboard;
+
+// windows holding back resize events until the end of the poll
+std::vector<GLFWNativeWindow*> g_CoalescedWindows;
+
+// window whose context is current on this thread, GLFW silently replaces
+// it when another context is made current
+thread_local GLFWNativeWindow* t_CurrentWindow = nullptr;
+
 }  // namespace
 
+//----------------------------------------------------------------------------
+//  GLFW Cursor Cache Implementation
+//----------------------------------------------------------------------------
+namespace {
+
+constexpr std::array<int, GLFWCursorCache::ShapeCount> GlfwCursorShapes{
+    GLFW_ARROW_CURSOR,
+    GLFW_IBEAM_CURSOR,
+    GLFW_CROSSHAIR_CURSOR,
+    GLFW_POINTING_HAND_CURSOR,
+    GLFW_RESIZE_EW_CURSOR,
+    GLFW_RESIZE_NS_CURSOR,
+    GLFW_RESIZE_NWSE_CURSOR,
+    GLFW_RESIZE_NESW_CURSOR,
+    GLFW_RESIZE_ALL_CURSOR,
+    GLFW_NOT_ALLOWED_CURSOR,
+};
+
+constexpr std::array<int, 4> GlfwCursorModes{
+    GLFW_CURSOR_NORMAL,
+    GLFW_CURSOR_HIDDEN,
+    GLFW_CURSOR_CAPTURED,
+    GLFW_CURSOR_DISABLED,
+};
+
+}  // namespace
+
+GLFWcursor* GLFWCursorCache::getStandard(CursorShape shape)
+{
+    size_t idx = static_cast<size_t>(shape);
+    if (!standard_[idx]) {
+        standard_[idx] = glfwCreateStandardCursor(GlfwCursorShapes[idx]);
+        if (!standard_[idx]) {
+            throw GLFWException("Failed to create standard cursor");
+        }
+    }
+    return standard_[idx];
+}
+
+GLFWcursor* GLFWCursorCache::getCustom(CursorHandle handle) const
+{
+    if (handle >= custom_.size()) {
+        throw std::out_of_range("Unknown cursor handle");
+    }
+    return custom_[handle];
+}
+
+CursorHandle GLFWCursorCache::createCustom(const CursorImage& image)
+{
+    size_t required = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+    if (image.width <= 0 || image.height <= 0 || image.pixels.size() < required) {
+        throw std::invalid_argument("Cursor image does not match its dimensions");
+    }
+
+    GLFWimage glfwImage{
+        .width = image.width,
+        .height = image.height,
+        // GLFW copies the pixels and never writes to them
+        .pixels = const_cast<unsigned char*>(image.pixels.data()),
+    };
+    GLFWcursor* cursor = glfwCreateCursor(&glfwImage, image.hotX, image.hotY);
+    if (!cursor) {
+        throw GLFWException("Failed to create cursor");
+    }
+    custom_.push_back(cursor);
+    return static_cast<CursorHandle>(custom_.size() - 1);
+}
+
+void GLFWCursorCache::clear() noexcept
+{
+    for (auto& cursor : standard_) {
+        if (cursor) {
+            glfwDestroyCursor(cursor);
+            cursor = nullptr;
+        }
+    }
+    for (auto* cursor : custom_) {
+        glfwDestroyCursor(cursor);
+    }
+    custom_.clear();
+}
+
+//----------------------------------------------------------------------------
+//  GLFW Key Name Table Implementation
+//----------------------------------------------------------------------------
+std::string_view GLFWKeyNameTable::getKeyName(Key key)
+{
+    if (!valid_) {
+        build();
+    }
+    size_t idx = static_cast<size_t>(key);
+    return idx < keyNames_.size() ? view(keyNames_[idx]) : std::string_view{};
+}
+
+std::string_view GLFWKeyNameTable::getScancodeName(int scancode)
+{
+    if (!valid_) {
+        build();
+    }
+    size_t idx = static_cast<size_t>(scancode);
+    return idx < scancodeNames_.size() ? view(scancodeNames_[idx]) : std::string_view{};
+}
+
+int GLFWKeyNameTable::getKeyScancode(Key key)
+{
+    if (!valid_) {
+        build();
+    }
+    size_t idx = static_cast<size_t>(key);
+    return idx < keyScancodes_.size() ? keyScancodes_[idx] : -1;
+}
+
+void GLFWKeyNameTable::invalidate() noexcept
+{
+    valid_ = false;
+}
+
+void GLFWKeyNameTable::checkLayout()
+{
+    if (!valid_) {
+        return;
+    }
+    for (Key key : ProbeKeys) {
+        const char* name = glfwGetKeyName(inputmap::toGlfwKey(key), 0);
+        if (std::string_view(name ? name : "") != view(keyNames_[static_cast<size_t>(key)])) {
+            valid_ = false;
+            return;
+        }
+    }
+}
+
+void GLFWKeyNameTable::build()
+{
+    names_.clear();
+    keyNames_.fill(Name{});
+    keyScancodes_.fill(-1);
+    scancodeNames_.fill(Name{});
+
+    // GLFW's name buffers are overwritten by the next call, copy each one
+    auto append = [this](const char* name) {
+        if (!name) {
+            return Name{};
+        }
+        Name entry{ static_cast<uint32_t>(names_.size()), 0 };
+        names_.append(name);
+        entry.length = static_cast<uint32_t>(names_.size()) - entry.offset;
+        return entry;
+    };
+
+    for (size_t i = static_cast<size_t>(Key::First); i <= static_cast<size_t>(Key::Last); ++i) {
+        int glfwKey = inputmap::toGlfwKey(static_cast<Key>(i));
+        if (glfwKey == GLFW_KEY_UNKNOWN) {
+            continue;
+        }
+        int scancode = glfwGetKeyScancode(glfwKey);
+        keyScancodes_[i] = scancode;
+        keyNames_[i] = append(glfwGetKeyName(glfwKey, 0));
+        if (static_cast<size_t>(scancode) < scancodeNames_.size()) {
+            scancodeNames_[static_cast<size_t>(scancode)] = keyNames_[i];
+        }
+    }
+    valid_ = true;
+}
+
+std::string_view GLFWKeyNameTable::view(Name name) const noexcept
+{
+    return std::string_view(names_).substr(name.offset, name.length);
+}
+
+//----------------------------------------------------------------------------
+//  GLFW Gamepad Mappings Implementation
+//----------------------------------------------------------------------------
+namespace {
+
+// platform names as used by the SDL mapping format
+std::string_view sdlPlatformName() noexcept
+{
+    switch (glfwGetPlatform()) {
+        case GLFW_PLATFORM_WIN32:
+            return "Windows";
+        case GLFW_PLATFORM_COCOA:
+            return "Mac OS X";
+        case GLFW_PLATFORM_WAYLAND:
+        case GLFW_PLATFORM_X11:
+            return "Linux";
+        default:
+            return {};
+    }
+}
+
+}  // namespace
+
+void GLFWGamepadMappings::load(const std::filesystem::path& path)
+{
+    if (files_.empty()) {
+        glfwSetJoystickCallback([](int jid, int event) {
+            if (event == GLFW_CONNECTED) {
+                g_Caches->gamepadMappings.onConnected(jid);
+            }
+        });
+    }
+    files_.emplace_back(path);
+
+    // the new file may override mappings that were already applied
+    indexed_ = false;
+    applied_.clear();
+    for (int jid = GLFW_JOYSTICK_1; jid <= GLFW_JOYSTICK_LAST; ++jid) {
+        if (glfwJoystickPresent(jid)) {
+            onConnected(jid);
+        }
+    }
+}
+
+void GLFWGamepadMappings::onConnected(int jid)
+{
+    const char* guid = glfwGetJoystickGUID(jid);
+    if (!guid) {
+        return;
+    }
+    if (!indexed_) {
+        buildIndex();
+    }
+
+    auto it = index_.find(std::string_view(guid));
+    if (it == index_.end() || applied_.contains(it->first)) {
+        return;
+    }
+    // GLFW wants a terminated string, copy just this line
+    std::string line(it->second);
+    if (glfwUpdateGamepadMappings(line.c_str())) {
+        applied_.insert(it->first);
+    }
+}
+
+void GLFWGamepadMappings::clear() noexcept
+{
+    index_.clear();
+    applied_.clear();
+    files_.clear();
+    indexed_ = false;
+}
+
+void GLFWGamepadMappings::buildIndex()
+{
+    constexpr std::string_view PlatformField = "platform:";
+    std::string_view platform = sdlPlatformName();
+
+    index_.clear();
+    for (const MappedFile& file : files_) {
+        std::string_view rest = file.data();
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            std::string_view line = rest.substr(0, end);
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            size_t comma = line.find(',');
+            if (line.empty() || line.front() == '#' || comma == std::string_view::npos) {
+                continue;
+            }
+
+            // lines without a platform field apply everywhere
+            if (size_t field = line.find(PlatformField); field != std::string_view::npos) {
+                std::string_view value = line.substr(field + PlatformField.size());
+                value = value.substr(0, value.find(','));
+                if (value != platform) {
+                    continue;
+                }
+            }
+            // later files override earlier ones
+            index_.insert_or_assign(line.substr(0, comma), line);
+        }
+    }
+    indexed_ = true;
+}
+
+//----------------------------------------------------------------------------
+//  GLFW Icon Cache Implementation
+//----------------------------------------------------------------------------
+std::span<const GLFWimage> GLFWIconCache::get(std::span<const IconImage> images)
+{
+    bool needsConversion = false;
+    uint64_t key = images.size();
+    for (const auto& image : images) {
+        size_t required = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+        if (image.width <= 0 || image.height <= 0 || image.pixels.size() < required) {
+            throw std::invalid_argument("Icon image does not match its dimensions");
+        }
+        needsConversion |= image.format != PixelFormat::RGBA8;
+    }
+
+    // GLFW copies the pixels, straight RGBA can be handed over as is
+    if (!needsConversion) {
+        passthrough_.clear();
+        for (const auto& image : images) {
+            passthrough_.push_back(
+                GLFWimage{
+                    .width = image.width,
+                    .height = image.height,
+                    .pixels = const_cast<unsigned char*>(image.pixels.data()),
+                });
+        }
+        return passthrough_;
+    }
+
+    for (const auto& image : images) {
+        uint32_t header[3] = {
+            static_cast<uint32_t>(image.width),
+            static_cast<uint32_t>(image.height),
+            static_cast<uint32_t>(image.format),
+        };
+        key = pixels::hash({ reinterpret_cast<const uint8_t*>(header), sizeof(header) }, key);
+        key = pixels::hash(image.pixels.first(image.width * image.height * 4), key);
+    }
+
+    ++useCount_;
+    for (auto& entry : entries_) {
+        // the hash only narrows the search, a collision must not show
+        // another icon set
+        if (entry.key == key && entry.matches(images)) {
+            entry.lastUse = useCount_;
+            return entry.images;
+        }
+    }
+
+    Entry* entry = nullptr;
+    if (entries_.size() < MaxEntries) {
+        entry = &entries_.emplace_back();
+    } else {
+        entry = &*std::min_element(
+            entries_.begin(),
+            entries_.end(),
+            [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+        // keep the buffers, only their contents change
+        entry->layout.clear();
+        entry->source.clear();
+        entry->images.clear();
+    }
+    entry->key = key;
+    entry->lastUse = useCount_;
+
+    size_t total = 0;
+    for (const auto& image : images) {
+        size_t bytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+        entry->layout.push_back(Layout{ image.width, image.height, image.format });
+        auto content = image.pixels.first(bytes);
+        entry->source.insert(entry->source.end(), content.begin(), content.end());
+        total += bytes;
+    }
+    entry->pixels.resize(total);
+
+    size_t offset = 0;
+    for (const auto& image : images) {
+        size_t bytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+        std::span<uint8_t> dst(entry->pixels.data() + offset, bytes);
+        pixels::convertToRGBA8(image.pixels.first(bytes), dst, image.format);
+        entry->images.push_back(
+            GLFWimage{
+                .width = image.width,
+                .height = image.height,
+                .pixels = dst.data(),
+            });
+        offset += bytes;
+    }
+    return entry->images;
+}
+
+bool GLFWIconCache::Entry::matches(std::span<const IconImage> images) const noexcept
+{
+    if (layout.size() != images.size()) {
+        return false;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < images.size(); ++i) {
+        const IconImage& image = images[i];
+        if (layout[i] != Layout{ image.width, image.height, image.format }) {
+            return false;
+        }
+        size_t bytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4;
+        if (std::memcmp(source.data() + offset, image.pixels.data(), bytes) != 0) {
+            return false;
+        }
+        offset += bytes;
+    }
+    return true;
+}
+
+void GLFWIconCache::clear() noexcept
+{
+    entries_.clear();
+    passthrough_.clear();
+}
+
+//----------------------------------------------------------------------------
+//  GLFW Proc Table Cache Implementation
+//----------------------------------------------------------------------------
+ProcFunction GLFWProcTableCache::resolve(std::string_view configKey, const char* name)
+{
+    std::lock_guard lock(mutex_);
+    auto tableIt = tables_.find(configKey);
+    if (tableIt == tables_.end()) {
+        tableIt = tables_.emplace(configKey, ProcTable{}).first;
+    }
+    ProcTable& table = tableIt->second;
+    if (auto it = table.find(std::string_view(name)); it != table.end()) {
+        return it->second;
+    }
+    // missing extensions are cached as null too
+    ProcFunction function = glfwGetProcAddress(name);
+    table.emplace(name, function);
+    return function;
+}
+
+void GLFWProcTableCache::clear() noexcept
+{
+    std::lock_guard lock(mutex_);
+    tables_.clear();
+}
+
+//----------------------------------------------------------------------------
+//  GLFW Clipboard Implementation
+//----------------------------------------------------------------------------
+void GLFWClipboard::write(GLFWwindow* window, std::string_view text)
+{
+    contents_.assign(text);
+    glfwSetClipboardString(window, contents_.c_str());
+    // we own the selection now, until another application takes it
+    valid_ = true;
+    fetched_ = std::chrono::steady_clock::now();
+}
+
+std::string_view GLFWClipboard::read()
+{
+    auto now = std::chrono::steady_clock::now();
+    // clipboard managers can take ownership while we stay focused, so the
+    // cache is only trusted for a short while
+    if (!valid_ || now - fetched_ > CacheLifetime) {
+        const char* text = glfwGetClipboardString(nullptr);
+        contents_.assign(text ? text : "");
+        valid_ = true;
+        fetched_ = now;
+    }
+    return contents_;
+}
+
+void GLFWClipboard::request(GLFWNativeWindow* window)
+{
+    // an explicit request always gets the current contents
+    valid_ = false;
+    if (std::find(pending_.begin(), pending_.end(), window) == pending_.end()) {
+        pending_.push_back(window);
+    }
+}
+
+void GLFWClipboard::cancel(GLFWNativeWindow* window) noexcept
+{
+    std::erase(pending_, window);
+}
+
+void GLFWClipboard::servicePending()
+{
+    if (pending_.empty()) {
+        return;
+    }
+    // one transfer at most, shared by every window that asked
+    std::string_view text = read();
+    for (auto* window : pending_) {
+        window->onClipboardReceived(text);
+    }
+    pending_.clear();
+}
+
+void GLFWClipboard::invalidate() noexcept
+{
+    valid_ = false;
+}
+
 //----------------------------------------------------------------------------
 //  GLFW Window Implementation
 //----------------------------------------------------------------------------
@@ -324,6 +732,8 @@ void setupGlfwWindowHints(const WindowDesc& desc)
     glfwWindowHint(GLFW_VISIBLE, desc.visible);
     glfwWindowHint(GLFW_FOCUSED, desc.focused);
     glfwWindowHint(GLFW_DECORATED, desc.decorated);
+    glfwWindowHint(GLFW_SCALE_TO_MONITOR, desc.scaleToMonitor);
+    glfwWindowHint(GLFW_SCALE_FRAMEBUFFER, desc.scaleFramebuffer);
     // special Window Hints
     const auto visitor = Visitor{
         [](NoneGraphicsModeTag mode) {
@@ -331,6 +741,10 @@ void setupGlfwWindowHints(const WindowDesc& desc)
         },
         [](OpenGLGraphicsModeTag mode) {
             glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+            // without a display only software contexts are available
+            if (glfwGetPlatform() == GLFW_PLATFORM_NULL) {
+                glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            }
             glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, mode.config.major);
             glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, mode.config.minor);
             glfwWindowHint(GLFW_OPENGL_CORE_PROFILE, mode.config.coreProfile);
@@ -339,6 +753,50 @@ void setupGlfwWindowHints(const WindowDesc& desc)
     std::visit(visitor, desc.mode);
 }
 
+// Describes the context that was actually created, hints may be rounded up.
+// Contexts with equal keys come from the same driver with the same version,
+// profile and flags, so their entry points are interchangeable. WGL may still
+// return different pointers per pixel format, so on Windows tables are not
+// shared beyond one share group. `handle`'s context must be current.
+std::string makeProcTableKey(GLFWwindow* const handle, const GLFWContextGroup& group)
+{
+    constexpr unsigned int GLVendor = 0x1F00;
+    constexpr unsigned int GLRenderer = 0x1F01;
+
+    std::string key;
+    for (int attribute : {
+             GLFW_CLIENT_API,
+             GLFW_CONTEXT_CREATION_API,
+             GLFW_CONTEXT_VERSION_MAJOR,
+             GLFW_CONTEXT_VERSION_MINOR,
+             GLFW_OPENGL_PROFILE,
+             GLFW_OPENGL_FORWARD_COMPAT,
+             GLFW_CONTEXT_DEBUG,
+             GLFW_CONTEXT_ROBUSTNESS,
+             GLFW_CONTEXT_NO_ERROR,
+         }) {
+        key += std::to_string(glfwGetWindowAttrib(handle, attribute));
+        key += '|';
+    }
+
+    // the driver only shows through the context itself
+    auto getString = reinterpret_cast<PFN_glGetString>(glfwGetProcAddress("glGetString"));
+    for (unsigned int name : { GLVendor, GLRenderer }) {
+        const unsigned char* value = getString ? getString(name) : nullptr;
+        if (value) {
+            key += reinterpret_cast<const char*>(value);
+        }
+        key += '|';
+    }
+
+#if defined(CPPWINDOW_PLATFORM_WINDOWS)
+    key += std::to_string(group.id);
+#else
+    (void)group;
+#endif
+    return key;
+}
+
 void registerGlfwCallbacks(GLFWwindow* const handle)
 {
     glfwSetFramebufferSizeCallback(handle, [](GLFWwindow* win, int w, int h) {
@@ -348,11 +806,7 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
         if (width == 0 || height == 0) {
             return;
         }
-        self->handleEvent(
-            Event::FrameBufferResized{
-                .width = width,
-                .height = height,
-            });
+        self->onFrameBufferResized(width, height);
     });
 
     glfwSetWindowCloseCallback(handle, [](GLFWwindow* window) {
@@ -364,6 +818,10 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
     glfwSetWindowFocusCallback(handle, [](GLFWwindow* window, int focused) {
         auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
         if (focused == GLFW_TRUE) {
+            // another application may have taken the clipboard or switched
+            // the keyboard layout meanwhile
+            g_Clipboard.invalidate();
+            g_Caches->keyNames.invalidate();
             self->handleEvent(Event::FocusGained{});
         } else {
             self->handleEvent(Event::FocusLost{});
@@ -371,18 +829,29 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
     });
 
     glfwSetWindowSizeCallback(handle, [](GLFWwindow* window, int width, int height) {
+        auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
+        self->onResized(width, height);
+    });
+
+    glfwSetWindowPosCallback(handle, [](GLFWwindow* window, int xpos, int ypos) {
+        auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
+        self->onMoved(xpos, ypos);
+    });
+
+    glfwSetWindowContentScaleCallback(handle, [](GLFWwindow* window, float xscale, float yscale) {
         auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
         self->handleEvent(
-            Event::Resized{
-                .width = width,
-                .height = height,
+            Event::ContentScaleChanged{
+                .scaleX = xscale,
+                .scaleY = yscale,
             });
     });
 
     glfwSetKeyCallback(handle, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
         auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
         Key mappedKey = inputmap::toKey(key);
-        if (mappedKey == Key::Unknown) {
+        // keys without a Key value still count for the scancode state
+        if (mappedKey == Key::Unknown && scancode < 0) {
             return;
         }
         if (action == GLFW_PRESS) {
@@ -408,6 +877,11 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
         }
     });
 
+    glfwSetCharCallback(handle, [](GLFWwindow* window, unsigned int codepoint) {
+        auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
+        self->handleEvent(Event::TextEntered{ .unicode = static_cast<char32_t>(codepoint) });
+    });
+
     glfwSetMouseButtonCallback(handle, [](GLFWwindow* window, int button, int action, int mods) {
         auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
         MouseButton mappedButton = inputmap::toMouseButton(button);
@@ -454,6 +928,11 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
             });
     });
 
+    glfwSetDropCallback(handle, [](GLFWwindow* window, int count, const char** paths) {
+        auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
+        self->onFilesDropped(count, paths);
+    });
+
     glfwSetCursorPosCallback(handle, [](GLFWwindow* window, double xpos, double ypos) {
         auto* self = static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(window));
         self->handleEvent(
@@ -468,37 +947,309 @@ void registerGlfwCallbacks(GLFWwindow* const handle)
 
 GLFWNativeWindow::GLFWNativeWindow(WindowDesc desc)
 {
+    // every OpenGL window belongs to a share group, either joined or its own
+    if (std::holds_alternative<OpenGLGraphicsModeTag>(desc.mode)) {
+        if (desc.contextGroup) {
+            contextGroup_ = std::static_pointer_cast<GLFWContextGroup>(desc.contextGroup);
+        } else {
+            contextGroup_ = std::make_shared<GLFWContextGroup>();
+        }
+    }
+
     setupGlfwWindowHints(desc);
     handle_.reset(glfwCreateWindow(
         desc.width,
         desc.height,
         desc.title.c_str(),
         nullptr,  // monitor (fullscreen later)
-        nullptr   // share
-        ));
+        contextGroup_ ? contextGroup_->shareSource() : nullptr));
 
     if (!handle_) {
         throw GLFWException("Failed to create window");
     }
+    if (contextGroup_) {
+        contextGroup_->members.push_back(handle_.get());
+    }
 
     // issue: https://github.com/glfw/glfw/issues/2060
     if (!desc.decorated) {
         glfwSetWindowAttrib(handle_.get(), GLFW_DECORATED, GLFW_FALSE);
     };
 
+    glfwGetWindowContentScale(handle_.get(), &contentScaleX_, &contentScaleY_);
+    std::tie(surfaceWidth_, surfaceHeight_) = getFrameBufferSize();
+    coalesceResize_ = desc.coalesceResize;
+    defaultCoalesceResize_ = desc.coalesceResize;
+    state_.title = desc.title;
+    state_.visible = desc.visible;
+    state_.decorated = desc.decorated;
+    glfwGetWindowPos(handle_.get(), &state_.x, &state_.y);
+    glfwGetWindowSize(handle_.get(), &state_.width, &state_.height);
+
     // set data and register callbacks
     glfwSetWindowUserPointer(handle_.get(), this);
     registerGlfwCallbacks(handle_.get());
-    // create storage and register to registry
-    storage_ = std::make_shared<WindowStorage>();
+    // create storage in the registry
+    storage_ = g_WindowRegistry.create();
+    storage().owner = this;
+}
 
-    // register to registry
-    g_WindowRegistry.registerStorage(storage_);
+GLFWNativeWindow::~GLFWNativeWindow()
+{
+    if (t_CurrentWindow == this) {
+        t_CurrentWindow = nullptr;
+    }
+    g_Clipboard.cancel(this);
+    std::erase(g_CoalescedWindows, this);
+    if (contextGroup_) {
+        std::erase(contextGroup_->members, handle_.get());
+    }
+    g_WindowRegistry.destroy(storage_);
+}
+
+WindowStorage& GLFWNativeWindow::storage() const noexcept
+{
+    // live for as long as the window
+    return *g_WindowRegistry.get(storage_);
 }
 
 void GLFWNativeWindow::handleEvent(Event&& event)
 {
-    storage_->eventQueue.push_back(std::move(event));
+    if (const auto* scale = event.getIf<Event::ContentScaleChanged>()) {
+        contentScaleX_ = scale->scaleX;
+        contentScaleY_ = scale->scaleY;
+    }
+    // first event this frame queues the window for the next reset
+    g_WindowRegistry.markDirty(storage_);
+    WindowStorage& data = storage();
+    if (const auto* text = event.getIf<Event::TextEntered>()) {
+        data.textInput.push_back(text->unicode);
+    }
+    data.inputState->handleEvent(event);
+    data.eventQueue.push_back(std::move(event));
+}
+
+void GLFWNativeWindow::setCursor(CursorShape shape)
+{
+    // the default cursor is the arrow, no need to create one for it
+    applyCursor(shape == CursorShape::Arrow ? nullptr : g_Caches->cursors.getStandard(shape));
+}
+
+void GLFWNativeWindow::setCursor(CursorHandle cursor)
+{
+    applyCursor(g_Caches->cursors.getCustom(cursor));
+}
+
+void GLFWNativeWindow::applyCursor(GLFWcursor* cursor) noexcept
+{
+    if (cursor == cursor_) {
+        return;
+    }
+    glfwSetCursor(handle_.get(), cursor);
+    cursor_ = cursor;
+}
+
+void GLFWNativeWindow::setCursorMode(CursorMode mode)
+{
+    if (mode == cursorMode_) {
+        return;
+    }
+    glfwSetInputMode(handle_.get(), GLFW_CURSOR, GlfwCursorModes[static_cast<size_t>(mode)]);
+    cursorMode_ = mode;
+}
+
+CursorMode GLFWNativeWindow::getCursorMode() const noexcept
+{
+    return cursorMode_;
+}
+
+void GLFWNativeWindow::setClipboard(std::string_view text)
+{
+    g_Clipboard.write(handle_.get(), text);
+}
+
+std::string_view GLFWNativeWindow::getClipboard()
+{
+    return g_Clipboard.read();
+}
+
+void GLFWNativeWindow::requestClipboard()
+{
+    g_Clipboard.request(this);
+}
+
+void GLFWNativeWindow::onFrameBufferResized(uint32_t width, uint32_t height)
+{
+    if (width != surfaceWidth_ || height != surfaceHeight_) {
+        surfaceWidth_ = width;
+        surfaceHeight_ = height;
+        surfaceDirty_ = true;
+        ++surfaceGeneration_;
+    }
+
+    if (!coalesceResize_) {
+        handleEvent(
+            Event::FrameBufferResized{
+                .width = width,
+                .height = height,
+            });
+        return;
+    }
+    if (!frameBufferResizePending_ && !resizePending_) {
+        g_CoalescedWindows.push_back(this);
+    }
+    frameBufferResizePending_ = true;
+}
+
+void GLFWNativeWindow::onMoved(int x, int y) noexcept
+{
+    state_.x = x;
+    state_.y = y;
+}
+
+void GLFWNativeWindow::onResized(int width, int height)
+{
+    state_.width = width;
+    state_.height = height;
+    if (!coalesceResize_) {
+        handleEvent(
+            Event::Resized{
+                .width = width,
+                .height = height,
+            });
+        return;
+    }
+    if (!frameBufferResizePending_ && !resizePending_) {
+        g_CoalescedWindows.push_back(this);
+    }
+    resizePending_ = true;
+    pendingWidth_ = width;
+    pendingHeight_ = height;
+}
+
+void GLFWNativeWindow::onClipboardReceived(std::string_view text)
+{
+    // copy into the window's arena, a later clipboard write must not change
+    // events that are already queued
+    char* chars = storage().arena.allocate<char>(text.size());
+    std::memcpy(chars, text.data(), text.size());
+    handleEvent(Event::ClipboardReceived{ .text = std::string_view(chars, text.size()) });
+}
+
+void GLFWNativeWindow::onFilesDropped(int count, const char** paths)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    // one block for the views and one for all characters, both from the
+    // window's arena so the event stays a pointer and a size
+    size_t pathCount = static_cast<size_t>(count);
+    FrameArena& arena = storage().arena;
+    std::string_view* views = arena.allocate<std::string_view>(pathCount);
+    size_t totalLength = 0;
+    for (size_t i = 0; i < pathCount; ++i) {
+        views[i] = std::string_view(paths[i]);
+        totalLength += views[i].size();
+    }
+
+    char* chars = arena.allocate<char>(totalLength);
+    for (size_t i = 0; i < pathCount; ++i) {
+        std::memcpy(chars, views[i].data(), views[i].size());
+        views[i] = std::string_view(chars, views[i].size());
+        chars += views[i].size();
+    }
+
+    double xpos, ypos;
+    glfwGetCursorPos(handle_.get(), &xpos, &ypos);
+    handleEvent(
+        Event::FilesDropped{
+            .paths = std::span<const std::string_view>(views, pathCount),
+            .posX = xpos,
+            .posY = ypos,
+        });
+}
+
+void GLFWNativeWindow::flushCoalescedEvents()
+{
+    if (resizePending_) {
+        handleEvent(
+            Event::Resized{
+                .width = pendingWidth_,
+                .height = pendingHeight_,
+            });
+    }
+    if (frameBufferResizePending_) {
+        handleEvent(
+            Event::FrameBufferResized{
+                .width = surfaceWidth_,
+                .height = surfaceHeight_,
+            });
+    }
+    resizePending_ = false;
+    frameBufferResizePending_ = false;
+}
+
+bool GLFWNativeWindow::isSurfaceDirty() const noexcept
+{
+    return surfaceDirty_;
+}
+
+uint64_t GLFWNativeWindow::getSurfaceGeneration() const noexcept
+{
+    return surfaceGeneration_;
+}
+
+std::pair<uint32_t, uint32_t> GLFWNativeWindow::acknowledgeSurface() noexcept
+{
+    surfaceDirty_ = false;
+    return { surfaceWidth_, surfaceHeight_ };
+}
+
+void GLFWNativeWindow::setResizeCoalescing(bool enabled) noexcept
+{
+    coalesceResize_ = enabled;
+}
+
+StorageHandle GLFWNativeWindow::getStorageHandle() const noexcept
+{
+    return storage_;
+}
+
+WindowId GLFWNativeWindow::getId() const noexcept
+{
+    return storage_;
+}
+
+void GLFWNativeWindow::injectEvent(Event event)
+{
+    handleEvent(std::move(event));
+}
+
+void GLFWNativeWindow::recycle() noexcept
+{
+    setVisible(false);
+    glfwSetWindowShouldClose(handle_.get(), GLFW_FALSE);
+    // events, arena, text input and input state, nothing of the previous
+    // user may reach the next one
+    WindowStorage& data = storage();
+    data.reset();
+    data.inputState->clear();
+    // drop resizes held back for this poll along with the coalescing mode
+    // the previous user may have switched
+    std::erase(g_CoalescedWindows, this);
+    frameBufferResizePending_ = false;
+    resizePending_ = false;
+    coalesceResize_ = defaultCoalesceResize_;
+    // surfaces belong to the caller, a new generation tells the next user
+    // to create its own rather than inherit one
+    std::tie(surfaceWidth_, surfaceHeight_) = getFrameBufferSize();
+    surfaceDirty_ = true;
+    ++surfaceGeneration_;
+    g_Clipboard.cancel(this);
+    applyCursor(nullptr);
+    setCursorMode(CursorMode::Normal);
+    resetFrameStats();
 }
 
 NativeHandles GLFWNativeWindow::getNativeHandles() const
@@ -515,11 +1266,11 @@ NativeHandles GLFWNativeWindow::getNativeHandles() const
     int platform = glfwGetPlatform();
     if (platform == GLFW_PLATFORM_X11) {
         handles.system = NativeHandles::System::X11;
-        handles.window = reinterpret_cast<void*>(glfwGetX11Window(m_window));
+        handles.window = reinterpret_cast<void*>(glfwGetX11Window(handle_.get()));
         handles.display = glfwGetX11Display();
     } else if (platform == GLFW_PLATFORM_WAYLAND) {
-        handles.system = NativeHandles::System::Wayland;
-        handles.window = glfwGetWaylandWindow(m_window);
+        handles.system = NativeHandles::System::WayLand;
+        handles.window = glfwGetWaylandWindow(handle_.get());
         handles.display = glfwGetWaylandDisplay();
     }
 #endif
@@ -527,7 +1278,7 @@ NativeHandles GLFWNativeWindow::getNativeHandles() const
     return handles;
 }
 
-VulkanHandle GLFWNativeWindow::createVulkanSurface(void* instance) const
+VulkanHandle GLFWNativeWindow::createVulkanSurface(void* instance, const void* allocator) const
 {
     VkSurfaceKHR surface = 0;
 
@@ -536,7 +1287,7 @@ VulkanHandle GLFWNativeWindow::createVulkanSurface(void* instance) const
     VkResult result = glfwCreateWindowSurface(
         static_cast<VkInstance>(instance),
         handle_.get(),
-        nullptr,
+        allocator,
         &surface);
     // VK_SUCCESS is 0
     if (result != 0) {
@@ -545,14 +1296,74 @@ VulkanHandle GLFWNativeWindow::createVulkanSurface(void* instance) const
     return static_cast<VulkanHandle>(surface);
 }
 
-void GLFWNativeWindow::makeContextCurrent()
+int32_t GLFWNativeWindow::recreateVulkanSurface(
+    void* instance,
+    VulkanHandle& surface,
+    const void* allocator) const noexcept
 {
+    auto vkInstance = static_cast<VkInstance>(instance);
+    if (surface != 0) {
+        // resolved through GLFW so we don't link against the loader ourselves
+        auto destroySurface = reinterpret_cast<PFN_vkDestroySurfaceKHR>(
+            glfwGetInstanceProcAddress(vkInstance, "vkDestroySurfaceKHR"));
+        if (!destroySurface) {
+            // leave the old surface with the caller rather than leaking it
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        destroySurface(vkInstance, static_cast<VkSurfaceKHR>(surface), allocator);
+        surface = 0;
+    }
+
+    VkSurfaceKHR created = 0;
+    VkResult result = glfwCreateWindowSurface(vkInstance, handle_.get(), allocator, &created);
+    if (result == 0) {
+        surface = static_cast<VulkanHandle>(created);
+    }
+    return result;
+}
+
+void GLFWNativeWindow::attachContext()
+{
+    std::thread::id self = std::this_thread::get_id();
+    std::thread::id expected{};
+    if (!contextOwner_.compare_exchange_strong(expected, self) && expected != self) {
+        throw std::logic_error("OpenGL context is current on another thread");
+    }
+    if (t_CurrentWindow && t_CurrentWindow != this) {
+        t_CurrentWindow->contextOwner_.store(std::thread::id{});
+    }
     glfwMakeContextCurrent(handle_.get());
+    t_CurrentWindow = this;
+}
+
+void GLFWNativeWindow::detachContext()
+{
+    if (t_CurrentWindow != this) {
+        return;
+    }
+    glfwMakeContextCurrent(nullptr);
+    t_CurrentWindow = nullptr;
+    contextOwner_.store(std::thread::id{});
+}
+
+bool GLFWNativeWindow::isContextCurrent() const noexcept
+{
+    return t_CurrentWindow == this;
 }
 
 void GLFWNativeWindow::swapBuffers()
 {
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
     glfwSwapBuffers(handle_.get());
+    auto end = clock::now();
+
+    swapTimings_.record(end - start);
+    if (lastPresent_ != clock::time_point{}) {
+        presentTimings_.record(end - lastPresent_);
+    }
+    lastPresent_ = end;
 }
 
 bool GLFWNativeWindow::shouldClose() const noexcept
@@ -567,32 +1378,99 @@ void GLFWNativeWindow::requestClose() noexcept
 
 std::span<Event> GLFWNativeWindow::events() const noexcept
 {
-    return storage_->eventQueue;
+    return storage().eventQueue;
+}
+
+std::u32string_view GLFWNativeWindow::getTextInput() const noexcept
+{
+    const WindowStorage& data = storage();
+    return std::u32string_view(data.textInput.data(), data.textInput.size());
+}
+
+std::string_view GLFWNativeWindow::getTextInputUtf8() const
+{
+    WindowStorage& data = storage();
+    std::u32string_view pending(data.textInput.data(), data.textInput.size());
+    pending.remove_prefix(data.textInputTranscoded);
+    if (!pending.empty()) {
+        utf::appendUtf8(pending, data.textInputUtf8);
+        data.textInputTranscoded = data.textInput.size();
+    }
+    return std::string_view(data.textInputUtf8.data(), data.textInputUtf8.size());
 }
 
 const NativeInputState* GLFWNativeWindow::getInput() const noexcept
 {
-    return storage_->inputState.get();
+    return storage().inputState.get();
+}
+
+void GLFWNativeWindow::setIcon(std::span<const IconImage> images)
+{
+    std::span<const GLFWimage> converted = g_Caches->icons.get(images);
+    glfwSetWindowIcon(handle_.get(), static_cast<int>(converted.size()), converted.data());
+}
+
+void GLFWNativeWindow::applyChanges(const WindowStateChange& changes)
+{
+    GLFWwindow* window = handle_.get();
+    bool show = changes.visible && *changes.visible && !state_.visible;
+    bool hide = changes.visible && !*changes.visible && state_.visible;
+
+    // hide first and show last, so the window manager never maps
+    // intermediate geometry
+    if (hide) {
+        setVisible(false);
+    }
+    if (changes.decorated && *changes.decorated != state_.decorated) {
+        glfwSetWindowAttrib(window, GLFW_DECORATED, *changes.decorated);
+        state_.decorated = *changes.decorated;
+    }
+    if (changes.size && *changes.size != std::pair{ state_.width, state_.height }) {
+        setSize(changes.size->first, changes.size->second);
+    }
+    if (changes.position && *changes.position != std::pair{ state_.x, state_.y }) {
+        glfwSetWindowPos(window, changes.position->first, changes.position->second);
+        state_.x = changes.position->first;
+        state_.y = changes.position->second;
+    }
+    if (changes.title && *changes.title != state_.title) {
+        setTitle(*changes.title);
+    }
+    if (show) {
+        setVisible(true);
+    }
 }
 
 void GLFWNativeWindow::setTitle(const std::string& title)
 {
     glfwSetWindowTitle(handle_.get(), title.c_str());
+    state_.title = title;
 }
 
 void GLFWNativeWindow::setSize(int width, int height)
 {
     glfwSetWindowSize(handle_.get(), width, height);
+    state_.width = width;
+    state_.height = height;
 }
 
 void GLFWNativeWindow::setFocus(bool focus) const noexcept
 {
-    glfwSetWindowAttrib(handle_.get(), GLFW_FOCUSED, focus);
+    // GLFW_FOCUSED is read-only, focus can only be requested
+    if (focus) {
+        glfwFocusWindow(handle_.get());
+    }
 }
 
 void GLFWNativeWindow::setVisible(bool visible) const noexcept
 {
-    glfwSetWindowAttrib(handle_.get(), GLFW_VISIBLE, visible);
+    // GLFW_VISIBLE is read-only, use show/hide instead
+    if (visible) {
+        glfwShowWindow(handle_.get());
+    } else {
+        glfwHideWindow(handle_.get());
+    }
+    state_.visible = visible;
 }
 
 std::pair<int, int> GLFWNativeWindow::getSize() const noexcept
@@ -615,6 +1493,11 @@ std::pair<uint32_t, uint32_t> GLFWNativeWindow::getFrameBufferSize() const noexc
     };
 }
 
+std::pair<float, float> GLFWNativeWindow::getContentScale() const noexcept
+{
+    return { contentScaleX_, contentScaleY_ };
+}
+
 bool GLFWNativeWindow::isFocused() const noexcept
 {
     return glfwGetWindowAttrib(handle_.get(), GLFW_FOCUSED) == GLFW_TRUE;
@@ -625,33 +1508,330 @@ bool GLFWNativeWindow::isVisible() const noexcept
     return glfwGetWindowAttrib(handle_.get(), GLFW_VISIBLE) == GLFW_TRUE;
 }
 
+double GLFWNativeWindow::getRefreshRate() const noexcept
+{
+    // windowed mode windows have no monitor, fall back to the primary one
+    GLFWmonitor* monitor = glfwGetWindowMonitor(handle_.get());
+    if (!monitor) {
+        monitor = glfwGetPrimaryMonitor();
+    }
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if (!mode || mode->refreshRate <= 0) {
+        return 60.0;
+    }
+    return static_cast<double>(mode->refreshRate);
+}
+
+FrameStats GLFWNativeWindow::getFrameStats() const noexcept
+{
+    return FrameStats{
+        .poll = g_PollTimings.summarize(),
+        .present = presentTimings_.summarize(),
+        .swap = swapTimings_.summarize(),
+    };
+}
+
+void GLFWNativeWindow::resetFrameStats() noexcept
+{
+    presentTimings_.clear();
+    swapTimings_.clear();
+    // lastPresent_ belongs to the swapping thread, the next present interval
+    // is still measured from the last real swap
+}
+
+std::shared_ptr<NativeContextGroup> GLFWNativeWindow::getContextGroup() const noexcept
+{
+    return contextGroup_;
+}
+
+const std::string& GLFWNativeWindow::getProcTableKey()
+{
+    // built by the first loader call, which runs with our context current,
+    // so window creation never switches contexts. Only the thread the
+    // context is current on gets here, which serializes the write.
+    if (procTableKey_.empty() && contextGroup_) {
+        procTableKey_ = makeProcTableKey(handle_.get(), *contextGroup_);
+    }
+    return procTableKey_;
+}
+
 //----------------------------------------------------------------------------
 //  GLFW Context Implementation
 //----------------------------------------------------------------------------
-GLFWWindowContext::GLFWWindowContext()
+namespace {
+
+int toGlfwPlatform(ContextOptions::Platform platform) noexcept
+{
+    switch (platform) {
+        case ContextOptions::Platform::Win32:
+            return GLFW_PLATFORM_WIN32;
+        case ContextOptions::Platform::Cocoa:
+            return GLFW_PLATFORM_COCOA;
+        case ContextOptions::Platform::Wayland:
+            return GLFW_PLATFORM_WAYLAND;
+        case ContextOptions::Platform::X11:
+            return GLFW_PLATFORM_X11;
+        case ContextOptions::Platform::Null:
+            return GLFW_PLATFORM_NULL;
+        default:
+            return GLFW_ANY_PLATFORM;
+    }
+}
+
+#if defined(CPPWINDOW_PLATFORM_LINUX)
+// GLFW loads the Wayland client library at runtime, so look the symbol up
+// in the copy already in the process instead of linking it
+template <typename Fn>
+Fn findLoadedSymbol(const char* library, const char* symbol) noexcept
+{
+    void* module = dlopen(library, RTLD_LAZY | RTLD_NOLOAD);
+    if (!module) {
+        return nullptr;
+    }
+    auto function = reinterpret_cast<Fn>(dlsym(module, symbol));
+    // drops only the reference taken above, GLFW keeps the library loaded
+    dlclose(module);
+    return function;
+}
+#endif
+
+ContextOptions::Platform fromGlfwPlatform(int platform) noexcept
 {
+    switch (platform) {
+        case GLFW_PLATFORM_WIN32:
+            return ContextOptions::Platform::Win32;
+        case GLFW_PLATFORM_COCOA:
+            return ContextOptions::Platform::Cocoa;
+        case GLFW_PLATFORM_WAYLAND:
+            return ContextOptions::Platform::Wayland;
+        case GLFW_PLATFORM_X11:
+            return ContextOptions::Platform::X11;
+        default:
+            return ContextOptions::Platform::Null;
+    }
+}
+
+}  // namespace
+
+GLFWWindowContext::GLFWWindowContext(const ContextOptions& options)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    int glfwPlatform = toGlfwPlatform(
+        options.headless ? ContextOptions::Platform::Null : options.platform);
+    if (glfwPlatform != GLFW_ANY_PLATFORM && !glfwPlatformSupported(glfwPlatform)) {
+        throw GLFWException("Requested platform is not supported by this GLFW build");
+    }
+
+    // init hints persist across glfwInit calls, set every one explicitly
+    glfwInitHint(GLFW_PLATFORM, glfwPlatform);
+    glfwInitHint(GLFW_JOYSTICK_HAT_BUTTONS, options.joystickHatButtons);
+    glfwInitHint(GLFW_X11_XCB_VULKAN_SURFACE, options.x11XcbVulkanSurface);
+    glfwInitHint(
+        GLFW_WAYLAND_LIBDECOR,
+        options.waylandLibdecor ? GLFW_WAYLAND_PREFER_LIBDECOR : GLFW_WAYLAND_DISABLE_LIBDECOR);
+    glfwInitHint(GLFW_COCOA_CHDIR_RESOURCES, options.cocoaChdirResources);
+    glfwInitHint(GLFW_COCOA_MENUBAR, options.cocoaMenubar);
+
     if (!glfwInit()) {
         throw GLFWException("Failed to initialize GLFW");
     }
+    initDuration_ = std::chrono::steady_clock::now() - start;
+    g_Caches = &caches_;
 }
 
 GLFWWindowContext::~GLFWWindowContext()
 {
+    // cursors must go while GLFW is alive, the rest is freed with caches_
+    caches_.cursors.clear();
+    glfwSetJoystickCallback(nullptr);
+    g_Caches = nullptr;
     glfwTerminate();
 }
 
-void GLFWWindowContext::pollEvents() noexcept
+void GLFWWindowContext::clearEvents() noexcept
+{
+    // one poll timing sample per frame, however many dispatches it took
+    if (dispatchCount_ != 0) {
+        g_PollTimings.record(dispatchTime_);
+        dispatchTime_ = {};
+        dispatchCount_ = 0;
+    }
+    // clear the event buffers of windows that had events last frame
+    g_WindowRegistry.resetDirty();
+}
+
+void GLFWWindowContext::dispatchPending() noexcept
 {
-    // clear old event buffers
-    g_WindowRegistry.resetAll();
-    // poll new events
+    auto start = std::chrono::steady_clock::now();
+    // apply window changes posted from other threads, events they trigger
+    // synchronously land in the current frame
+    applyPostedCommands();
+    // process whatever is pending, never blocks
     glfwPollEvents();
+    // the layout may have been switched while we kept focus
+    caches_.keyNames.checkLayout();
+    // answer clipboard requests made since the last poll
+    g_Clipboard.servicePending();
+    // one resize per window for everything that happened during the poll
+    for (auto* window : g_CoalescedWindows) {
+        window->flushCoalescedEvents();
+    }
+    g_CoalescedWindows.clear();
+    dispatchTime_ += std::chrono::steady_clock::now() - start;
+    ++dispatchCount_;
+}
+
+int GLFWWindowContext::getEventFileDescriptor() const noexcept
+{
+#if defined(CPPWINDOW_PLATFORM_LINUX)
+    switch (glfwGetPlatform()) {
+        case GLFW_PLATFORM_X11:
+            // a macro reading the Display struct, no libX11 call needed
+            return ConnectionNumber(glfwGetX11Display());
+        case GLFW_PLATFORM_WAYLAND:
+            if (auto getFd = findLoadedSymbol<int (*)(wl_display*)>(
+                    "libwayland-client.so.0",
+                    "wl_display_get_fd")) {
+                return getFd(glfwGetWaylandDisplay());
+            }
+            break;
+        default:
+            break;
+    }
+#endif
+    return -1;
+}
+
+std::span<const WindowId> GLFWWindowContext::getWindowsWithEvents() const noexcept
+{
+    return g_WindowRegistry.dirty();
+}
+
+std::string_view GLFWWindowContext::getKeyName(Key key) const
+{
+    return caches_.keyNames.getKeyName(key);
+}
+
+std::string_view GLFWWindowContext::getScancodeName(int scancode) const
+{
+    return caches_.keyNames.getScancodeName(scancode);
+}
+
+int GLFWWindowContext::getKeyScancode(Key key) const
+{
+    return caches_.keyNames.getKeyScancode(key);
+}
+
+void GLFWWindowContext::loadGamepadMappings(const std::filesystem::path& path)
+{
+    caches_.gamepadMappings.load(path);
+}
+
+bool GLFWWindowContext::isHeadless() const noexcept
+{
+    return glfwGetPlatform() == GLFW_PLATFORM_NULL;
+}
+
+ContextOptions::Platform GLFWWindowContext::getPlatform() const noexcept
+{
+    return fromGlfwPlatform(glfwGetPlatform());
+}
+
+std::chrono::nanoseconds GLFWWindowContext::getInitDuration() const noexcept
+{
+    return initDuration_;
+}
+
+CursorHandle GLFWWindowContext::createCursor(const CursorImage& image)
+{
+    return caches_.cursors.createCustom(image);
+}
+
+void GLFWWindowContext::postCommand(NativeWindow& window, WindowCommand::Data command)
+{
+    auto& glfwWindow = static_cast<GLFWNativeWindow&>(window);
+    commands_.push(
+        PostedCommand{
+            .target = glfwWindow.getStorageHandle(),
+            .command = std::move(command),
+        });
+}
+
+void GLFWWindowContext::applyPostedCommands()
+{
+    commands_.drain([this](PostedCommand& posted) {
+        commandBuffer_.push_back(std::move(posted));
+    });
+    if (commandBuffer_.empty()) {
+        return;
+    }
+
+    // walk backwards so the last command of each kind per window wins, one
+    // bit per command kind in the window's registry slot marks what is taken
+    static_assert(std::variant_size_v<WindowCommand::Data> <= 8);
+    for (size_t i = commandBuffer_.size(); i-- > 0;) {
+        auto& posted = commandBuffer_[i];
+        if (!g_WindowRegistry.contains(posted.target)) {
+            posted.target = {};
+            continue;
+        }
+        if (posted.target.index >= commandSeen_.size()) {
+            commandSeen_.resize(posted.target.index + 1);
+        }
+        const auto bit = static_cast<uint8_t>(1u << posted.command.index());
+        uint8_t& seen = commandSeen_[posted.target.index];
+        if (seen & bit) {
+            // a later command supersedes this one
+            posted.target = {};
+            continue;
+        }
+        seen |= bit;
+    }
+    // only the slots marked above are cleared, the rest are already zero
+    for (const auto& posted : commandBuffer_) {
+        if (posted.target.index < commandSeen_.size()) {
+            commandSeen_[posted.target.index] = 0;
+        }
+    }
+
+    for (auto& posted : commandBuffer_) {
+        WindowStorage* storage = g_WindowRegistry.get(posted.target);
+        if (!storage) {
+            continue;
+        }
+        GLFWNativeWindow* window = storage->owner;
+        const auto visitor = Visitor{
+            [window](WindowCommand::SetTitle& cmd) {
+                window->setTitle(cmd.title);
+            },
+            [window](WindowCommand::SetSize& cmd) {
+                window->setSize(cmd.width, cmd.height);
+            },
+            [window](WindowCommand::SetVisible& cmd) {
+                window->setVisible(cmd.visible);
+            },
+        };
+        std::visit(visitor, posted.command);
+    }
+    commandBuffer_.clear();
 }
 
 ProcLoader GLFWWindowContext::getProcLoader() const
 {
     return [](const char* name) -> ProcFunction {
-        return glfwGetProcAddress(name);
+        GLFWwindow* current = glfwGetCurrentContext();
+        auto* window = current ? static_cast<GLFWNativeWindow*>(glfwGetWindowUserPointer(current))
+                               : nullptr;
+        // contexts not created by us can't be matched to a table
+        if (!window || !g_Caches) {
+            return glfwGetProcAddress(name);
+        }
+        const std::string& key = window->getProcTableKey();
+        if (key.empty()) {
+            return glfwGetProcAddress(name);
+        }
+        return g_Caches->procTables.resolve(key, name);
     };
 }
 
@@ -660,12 +1840,27 @@ bool GLFWWindowContext::isVulkanSupported() const
     return glfwVulkanSupported();
 }
 
-std::vector<std::string> GLFWWindowContext::getRequiredVulkanExtensions() const
+bool GLFWWindowContext::isPresentationSupported(
+    void* instance,
+    void* physicalDevice,
+    uint32_t queueFamily) const noexcept
+{
+    return glfwGetPhysicalDevicePresentationSupport(
+               static_cast<VkInstance>(instance),
+               static_cast<VkPhysicalDevice>(physicalDevice),
+               queueFamily)
+        == GLFW_TRUE;
+}
+
+std::span<const char* const> GLFWWindowContext::getRequiredVulkanExtensions() const
 {
     uint32_t count = 0;
+    // GLFW owns the array until termination, null if Vulkan is unavailable
     const char** ext = glfwGetRequiredInstanceExtensions(&count);
-
-    return std::vector<std::string>(ext, ext + count);
+    if (!ext) {
+        return {};
+    }
+    return std::span<const char* const>(ext, count);
 }
 
 //----------------------------------------------------------------------------
@@ -673,9 +1868,9 @@ std::vector<std::string> GLFWWindowContext::getRequiredVulkanExtensions() const
 //----------------------------------------------------------------------------
 namespace factory {
 
-std::unique_ptr<NativeWindowContext> createNativeContext()
+std::unique_ptr<NativeWindowContext> createNativeContext(const ContextOptions& options)
 {
-    return std::make_unique<GLFWWindowContext>();
+    return std::make_unique<GLFWWindowContext>(options);
 }
 
 std::unique_ptr<NativeWindow> createNativeWindow(WindowDesc desc)
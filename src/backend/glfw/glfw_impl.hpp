@@ -12,13 +12,25 @@
 // Prevent GLFW from including OpenGL headers
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <cstring>
 #include <format>
+#include <mutex>
 #include <stdexcept>
 #include <string>
-
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../frame_arena.hpp"
+#include "../../mapped_file.hpp"
+#include "../../mpsc_queue.hpp"
+#include "../../timing_histogram.hpp"
 #include "../../window_registry.hpp"
 #include "../native_impl.hpp"
+#include "glfw_input_map.hpp"
 
 class GLFWException : public std::runtime_error
 {
@@ -53,38 +65,6 @@ private:
 
 namespace cwin {
 
-//----------------------------------------------------------------------------
-//  GLFW Input Mapping
-//----------------------------------------------------------------------------
-struct GlfwKeyMapTraits
-{
-    using WrapperType = Key;
-    using BackendType = int;
-
-    static constexpr Key WrapperNone = Key::Unknown;
-    static constexpr Key WrapperFirst = Key::First;
-    static constexpr Key WrapperLast = Key::Last;
-    static constexpr int BackendNone = GLFW_KEY_UNKNOWN;
-    static constexpr int BackendFirst = GLFW_KEY_SPACE;
-    static constexpr int BackendLast = GLFW_KEY_LAST;
-};
-
-struct GlfwMouseMapTraits
-{
-    using WrapperType = MouseButton;
-    using BackendType = int;
-
-    static constexpr MouseButton WrapperNone = MouseButton::Unknown;
-    static constexpr MouseButton WrapperFirst = MouseButton::First;
-    static constexpr MouseButton WrapperLast = MouseButton::Last;
-    static constexpr int BackendNone = GLFW_MOUSE_BUTTON_1;
-    static constexpr int BackendFirst = GLFW_MOUSE_BUTTON_1;
-    static constexpr int BackendLast = GLFW_MOUSE_BUTTON_LAST;
-};
-
-using KeyMapLookup = StaticLookup<GlfwKeyMapTraits>;
-using MouseMapLookup = StaticLookup<GlfwMouseMapTraits>;
-
 namespace inputmap {
 
 int toGlfwKey(Key k);
@@ -99,13 +79,20 @@ MouseButton toMouseButton(int b);
 //----------------------------------------------------------------------------
 class GLFWInputState : public NativeInputState
 {
+public:
+    static constexpr size_t ScancodeCount = 512;
+
     void handleEvent(const Event& event) override;
     void reset() override;
+    void clear() override;
 
     // keyboard
     bool isKeyDown(Key key) const override;
     bool isKeyPressed(Key key) const override;
     bool isKeyReleased(Key key) const override;
+    bool isScancodeDown(int scancode) const override;
+    bool isScancodePressed(int scancode) const override;
+    bool isScancodeReleased(int scancode) const override;
 
     // mouse
     bool isMouseButtonDown(MouseButton button) const override;
@@ -115,11 +102,15 @@ class GLFWInputState : public NativeInputState
     std::pair<double, double> getScrollDelta() const override;
 
 private:
-    std::bitset<KeyCount> keyStates_{};
-    std::bitset<KeyCount> prevKeyStates_{};
+    // indexed by the raw enum value, slot 0 belongs to `Unknown`
+    std::bitset<KeyCount + 1> keyStates_{};
+    std::bitset<KeyCount + 1> prevKeyStates_{};
+    // covers X11/Wayland (8..255), macOS and Win32 extended scancodes
+    std::bitset<ScancodeCount> scancodeStates_{};
+    std::bitset<ScancodeCount> prevScancodeStates_{};
 
-    std::bitset<MouseButtonCount> mouseStates_{};
-    std::bitset<MouseButtonCount> prevMouseStates_{};
+    std::bitset<MouseButtonCount + 1> mouseStates_{};
+    std::bitset<MouseButtonCount + 1> prevMouseStates_{};
 
     double mousePosX_{}, mousePosY_{};
     double scrollDeltaX_{}, scrollDeltaY_{};
@@ -140,51 +131,359 @@ struct GLFWwindowDeleter
 
 using UniqueGLFWwindow = std::unique_ptr<GLFWwindow, GLFWwindowDeleter>;
 
+class GLFWNativeWindow;
+
 class WindowStorage
 {
 public:
+    GLFWNativeWindow* owner = nullptr;
     std::vector<Event> eventQueue;
-    std::unique_ptr<NativeInputState> inputState;
+    std::unique_ptr<NativeInputState> inputState = std::make_unique<GLFWInputState>();
+    // backs variable-sized event payloads such as dropped paths
+    FrameArena arena;
+    // characters entered this frame, the UTF-8 copy is filled lazily and
+    // only for the code points not yet transcoded. Vectors rather than
+    // strings so views stay valid when the registry moves the storage.
+    std::vector<char32_t> textInput;
+    std::vector<char> textInputUtf8;
+    size_t textInputTranscoded = 0;
 
     void reset()
     {
         eventQueue.clear();
-        inputState.reset();
+        arena.reset();
+        textInput.clear();
+        textInputUtf8.clear();
+        textInputTranscoded = 0;
+        // rotate current input state into previous
+        inputState->reset();
     }
 };
 
+// Cursor objects are global in GLFW, create each one once and share it
+// between windows until the context shuts down
+class GLFWCursorCache
+{
+public:
+    static constexpr size_t ShapeCount = static_cast<size_t>(CursorShape::Last) + 1;
+
+    GLFWcursor* getStandard(CursorShape shape);
+    GLFWcursor* getCustom(CursorHandle handle) const;
+    CursorHandle createCustom(const CursorImage& image);
+    void clear() noexcept;
+
+private:
+    std::array<GLFWcursor*, ShapeCount> standard_{};
+    std::vector<GLFWcursor*> custom_;
+};
+
+// Key names depend on the keyboard layout, which GLFW reports no changes
+// for. The table is built on first use and dropped whenever a window regains
+// focus, the usual point at which the layout may have been switched.
+class GLFWKeyNameTable
+{
+public:
+    std::string_view getKeyName(Key key);
+    std::string_view getScancodeName(int scancode);
+    int getKeyScancode(Key key);
+    void invalidate() noexcept;
+    // GLFW reports no layout changes, so once per poll a few probe keys are
+    // named again and the table dropped if any name differs
+    void checkLayout();
+
+private:
+    struct Name
+    {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    // letters that move or change script between common layouts
+    // (QWERTY/AZERTY/QWERTZ, Latin/Cyrillic/Greek)
+    static constexpr std::array<Key, 3> ProbeKeys = { Key::Q, Key::W, Key::Y };
+
+    void build();
+    std::string_view view(Name name) const noexcept;
+
+    bool valid_ = false;
+    // every name back to back, entries below refer into it
+    std::string names_;
+    std::array<Name, KeyCount + 1> keyNames_{};
+    std::array<int, KeyCount + 1> keyScancodes_{};
+    std::array<Name, GLFWInputState::ScancodeCount> scancodeNames_{};
+};
+
+// SDL mapping databases hold thousands of lines for every platform. Files are
+// only mapped on load, the GUID index is built the first time a joystick
+// needs it and GLFW is handed single lines for the joysticks that connect.
+class GLFWGamepadMappings
+{
+public:
+    void load(const std::filesystem::path& path);
+    void onConnected(int jid);
+    void clear() noexcept;
+
+private:
+    void buildIndex();
+
+    std::vector<MappedFile> files_;
+    bool indexed_ = false;
+    // GUID -> complete mapping line, both viewing into files_
+    std::unordered_map<std::string_view, std::string_view> index_;
+    std::unordered_set<std::string_view> applied_;
+};
+
+// Icon sets converted to GLFW's straight RGBA layout, so applying the same
+// set to many windows converts it once. Entries are found by a content hash
+// and confirmed against a copy of the source, the least recently used one
+// is dropped once MaxEntries sets are cached. GLFW copies the pixels, so a
+// returned span only has to outlive the glfwSetWindowIcon call.
+class GLFWIconCache
+{
+public:
+    static constexpr size_t MaxEntries = 8;
+
+    std::span<const GLFWimage> get(std::span<const IconImage> images);
+    void clear() noexcept;
+
+private:
+    struct Layout
+    {
+        int width;
+        int height;
+        PixelFormat format;
+
+        bool operator==(const Layout&) const = default;
+    };
+
+    struct Entry
+    {
+        uint64_t key = 0;
+        uint64_t lastUse = 0;
+        std::vector<Layout> layout;
+        std::vector<uint8_t> source;
+        std::vector<uint8_t> pixels;
+        std::vector<GLFWimage> images;
+
+        bool matches(std::span<const IconImage> images) const noexcept;
+    };
+
+    std::vector<Entry> entries_;
+    uint64_t useCount_ = 0;
+    // scratch for sets that need no conversion
+    std::vector<GLFWimage> passthrough_;
+};
+
+// GLFW only allows clipboard access from the main thread and a read can
+// block on a selection transfer (X11), so reads stay synchronous. The cache
+// only collapses repeated reads: it expires after CacheLifetime, on focus
+// changes and on every requestClipboard, and all requests made during a
+// frame share the single transfer done in the next poll.
+class GLFWClipboard
+{
+public:
+    static constexpr std::chrono::milliseconds CacheLifetime{ 100 };
+
+    void write(GLFWwindow* window, std::string_view text);
+    std::string_view read();
+    void request(GLFWNativeWindow* window);
+    void cancel(GLFWNativeWindow* window) noexcept;
+    void servicePending();
+    void invalidate() noexcept;
+
+private:
+    std::string contents_;
+    bool valid_ = false;
+    std::chrono::steady_clock::time_point fetched_{};
+    std::vector<GLFWNativeWindow*> pending_;
+};
+
+// OpenGL entry points resolved once per context configuration. Contexts
+// created by the same driver with the same version, profile and flags get
+// the same pointers, so later contexts only pay for a hash lookup.
+class GLFWProcTableCache
+{
+public:
+    ProcFunction resolve(std::string_view configKey, const char* name);
+    void clear() noexcept;
+
+private:
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+    using ProcTable = std::unordered_map<std::string, ProcFunction, NameHash, std::equal_to<>>;
+
+    // loaders may run on render threads
+    std::mutex mutex_;
+    std::unordered_map<std::string, ProcTable, NameHash, std::equal_to<>> tables_;
+};
+
+// Caches shared by all windows. The context owns them, so they live exactly
+// as long as GLFW is initialized and never depend on static destruction order.
+struct GLFWSharedCaches
+{
+    // standard and custom cursors
+    GLFWCursorCache cursors;
+    // layout-dependent key names
+    GLFWKeyNameTable keyNames;
+    // mapping files, applied per connected joystick
+    GLFWGamepadMappings gamepadMappings;
+    // converted window icon sets
+    GLFWIconCache icons;
+    // OpenGL function tables shared by compatible contexts
+    GLFWProcTableCache procTables;
+};
+
+class GLFWContextGroup : public NativeContextGroup
+{
+public:
+    // any live member can serve as the share source for a new context
+    GLFWwindow* shareSource() const noexcept
+    {
+        return members.empty() ? nullptr : members.front();
+    }
+
+    std::vector<GLFWwindow*> members;
+    // unlike the address, never reused by a later group
+    const uint64_t id = ++s_LastId;
+
+private:
+    static inline uint64_t s_LastId = 0;
+};
+
 class GLFWNativeWindow : public NativeWindow
 {
 public:
     explicit GLFWNativeWindow(WindowDesc desc);
-    ~GLFWNativeWindow() = default;
+    ~GLFWNativeWindow();
 
     void handleEvent(Event&& event);
     void registerCallbacks();
 
+    void onFrameBufferResized(uint32_t width, uint32_t height);
+    void onResized(int width, int height);
+    void onMoved(int x, int y) noexcept;
+    void onFilesDropped(int count, const char** paths);
+    void onClipboardReceived(std::string_view text);
+    // emit the resize events held back during the last poll
+    void flushCoalescedEvents();
+
     NativeHandles getNativeHandles() const override;
-    VulkanHandle createVulkanSurface(void* instance) const override;
-    void makeContextCurrent() override;
+    VulkanHandle createVulkanSurface(void* instance, const void* allocator) const override;
+    int32_t recreateVulkanSurface(
+        void* instance,
+        VulkanHandle& surface,
+        const void* allocator) const noexcept override;
+    void attachContext() override;
+    void detachContext() override;
+    bool isContextCurrent() const noexcept override;
     void swapBuffers() override;
 
     bool shouldClose() const noexcept override;
     void requestClose() noexcept override;
 
     std::span<Event> events() const noexcept override;
+    std::u32string_view getTextInput() const noexcept override;
+    std::string_view getTextInputUtf8() const override;
     const NativeInputState* getInput() const noexcept override;
 
+    void setIcon(std::span<const IconImage> images) override;
+    void applyChanges(const WindowStateChange& changes) override;
     void setTitle(const std::string& title) override;
     void setSize(int width, int height) override;
     void setFocus(bool focus) const noexcept override;
     void setVisible(bool visible) const noexcept override;
     std::pair<int, int> getSize() const noexcept override;
     std::pair<uint32_t, uint32_t> getFrameBufferSize() const noexcept override;
+    std::pair<float, float> getContentScale() const noexcept override;
+    bool isSurfaceDirty() const noexcept override;
+    uint64_t getSurfaceGeneration() const noexcept override;
+    std::pair<uint32_t, uint32_t> acknowledgeSurface() noexcept override;
+    void setResizeCoalescing(bool enabled) noexcept override;
     bool isFocused() const noexcept override;
     bool isVisible() const noexcept override;
+    double getRefreshRate() const noexcept override;
+
+    FrameStats getFrameStats() const noexcept override;
+    void resetFrameStats() noexcept override;
+
+    std::shared_ptr<NativeContextGroup> getContextGroup() const noexcept override;
+
+    void setCursor(CursorShape shape) override;
+    void setCursor(CursorHandle cursor) override;
+    void setCursorMode(CursorMode mode) override;
+    CursorMode getCursorMode() const noexcept override;
+
+    void setClipboard(std::string_view text) override;
+    std::string_view getClipboard() override;
+    void requestClipboard() override;
+
+    void injectEvent(Event event) override;
+    void recycle() noexcept override;
+
+    StorageHandle getStorageHandle() const noexcept;
+    WindowId getId() const noexcept override;
+    // Call with this window's context current
+    const std::string& getProcTableKey();
 
 private:
+    void applyCursor(GLFWcursor* cursor) noexcept;
+
     UniqueGLFWwindow handle_{};
-    std::shared_ptr<WindowStorage> storage_{};
+    std::shared_ptr<GLFWContextGroup> contextGroup_{};
+    // selects the proc table in GLFWProcTableCache, empty until first
+    // resolved and without OpenGL
+    std::string procTableKey_;
+    // thread the OpenGL context is current on, default id if none
+    std::atomic<std::thread::id> contextOwner_{};
+
+    // last known window state, lets transactions skip no-op changes
+    // without querying the window system
+    struct StateCache
+    {
+        std::string title;
+        int x = 0, y = 0;
+        int width = 0, height = 0;
+        bool visible = false;
+        bool decorated = true;
+    };
+    mutable StateCache state_{};
+
+    float contentScaleX_ = 1.0f;
+    float contentScaleY_ = 1.0f;
+
+    // latest framebuffer extent, coalesced across a poll
+    uint32_t surfaceWidth_ = 0;
+    uint32_t surfaceHeight_ = 0;
+    uint64_t surfaceGeneration_ = 0;
+    bool surfaceDirty_ = false;
+
+    bool coalesceResize_ = false;
+    // as built, restored when the window is recycled
+    bool defaultCoalesceResize_ = false;
+    bool frameBufferResizePending_ = false;
+    bool resizePending_ = false;
+    int pendingWidth_ = 0;
+    int pendingHeight_ = 0;
+
+    // last applied cursor state, nullptr is the default arrow
+    GLFWcursor* cursor_ = nullptr;
+    CursorMode cursorMode_ = CursorMode::Normal;
+    WindowStorage& storage() const noexcept;
+
+    StorageHandle storage_{};
+
+    // recorded by whichever thread swaps buffers (see RenderThread), read
+    // and cleared from any thread
+    TimingHistogram presentTimings_{};
+    TimingHistogram swapTimings_{};
+    // only touched by the swapping thread
+    std::chrono::steady_clock::time_point lastPresent_{};
 };
 
 //----------------------------------------------------------------------------
@@ -193,14 +492,52 @@ private:
 class GLFWWindowContext : public NativeWindowContext
 {
 public:
-    GLFWWindowContext();
+    explicit GLFWWindowContext(const ContextOptions& options);
     ~GLFWWindowContext();
 
-    void pollEvents() noexcept override;
+    void dispatchPending() noexcept override;
+    void clearEvents() noexcept override;
+    int getEventFileDescriptor() const noexcept override;
+    std::span<const WindowId> getWindowsWithEvents() const noexcept override;
+    std::string_view getKeyName(Key key) const override;
+    std::string_view getScancodeName(int scancode) const override;
+    int getKeyScancode(Key key) const override;
+    void loadGamepadMappings(const std::filesystem::path& path) override;
+    bool isHeadless() const noexcept override;
+    ContextOptions::Platform getPlatform() const noexcept override;
+    std::chrono::nanoseconds getInitDuration() const noexcept override;
+
+    CursorHandle createCursor(const CursorImage& image) override;
+    void postCommand(NativeWindow& window, WindowCommand::Data command) override;
 
     ProcLoader getProcLoader() const override;
     bool isVulkanSupported() const override;
-    std::vector<std::string> getRequiredVulkanExtensions() const override;
+    bool isPresentationSupported(
+        void* instance,
+        void* physicalDevice,
+        uint32_t queueFamily) const noexcept override;
+    std::span<const char* const> getRequiredVulkanExtensions() const override;
+
+private:
+    struct PostedCommand
+    {
+        StorageHandle target;
+        WindowCommand::Data command;
+    };
+
+    void applyPostedCommands();
+
+    // built lazily, even from const queries
+    mutable GLFWSharedCaches caches_;
+    std::chrono::nanoseconds initDuration_{};
+    // dispatchPending time since the last clearEvents, recorded as one sample
+    std::chrono::nanoseconds dispatchTime_{};
+    uint32_t dispatchCount_ = 0;
+    MpscQueue<PostedCommand> commands_;
+    // reused every poll to collapse redundant commands
+    std::vector<PostedCommand> commandBuffer_;
+    // per registry slot, a bit for each command kind already kept this poll
+    std::vector<uint8_t> commandSeen_;
 };
 
 }  // namespace cwin
@@ -25,6 +25,13 @@ struct OpenGLGraphicsModeTag
 
 using GraphicsModeTag = std::variant<NoneGraphicsModeTag, OpenGLGraphicsModeTag>;
 
+// Set of OpenGL contexts sharing their objects, owned by the backend
+class NativeContextGroup
+{
+public:
+    virtual ~NativeContextGroup() = default;
+};
+
 struct WindowDesc
 {
     GraphicsModeTag mode;
@@ -35,6 +42,32 @@ struct WindowDesc
     bool visible;
     bool decorated;
     bool focused;
+    bool scaleToMonitor;
+    bool scaleFramebuffer;
+    bool coalesceResize;
+    std::shared_ptr<NativeContextGroup> contextGroup;
+};
+
+// Window mutation posted from any thread, applied during pollEvents
+struct WindowCommand
+{
+    struct SetTitle
+    {
+        std::string title;
+    };
+
+    struct SetSize
+    {
+        int width;
+        int height;
+    };
+
+    struct SetVisible
+    {
+        bool visible;
+    };
+
+    using Data = std::variant<SetTitle, SetSize, SetVisible>;
 };
 
 //----------------------------------------------------------------------------
@@ -48,11 +81,15 @@ public:
 
     virtual void handleEvent(const Event& event) = 0;
     virtual void reset() = 0;
+    virtual void clear() = 0;
 
     // keyboard
     virtual bool isKeyDown(Key key) const = 0;
     virtual bool isKeyPressed(Key key) const = 0;
     virtual bool isKeyReleased(Key key) const = 0;
+    virtual bool isScancodeDown(int scancode) const = 0;
+    virtual bool isScancodePressed(int scancode) const = 0;
+    virtual bool isScancodeReleased(int scancode) const = 0;
 
     // mouse
     virtual bool isMouseButtonDown(MouseButton button) const = 0;
@@ -71,24 +108,59 @@ public:
     virtual ~NativeWindow() = default;
 
     virtual NativeHandles getNativeHandles() const = 0;
-    virtual VulkanHandle createVulkanSurface(void* instance) const = 0;
-    virtual void makeContextCurrent() = 0;
+    virtual VulkanHandle createVulkanSurface(void* instance, const void* allocator) const = 0;
+    virtual int32_t recreateVulkanSurface(
+        void* instance,
+        VulkanHandle& surface,
+        const void* allocator) const noexcept = 0;
+    virtual void attachContext() = 0;
+    virtual void detachContext() = 0;
+    virtual bool isContextCurrent() const noexcept = 0;
     virtual void swapBuffers() = 0;
 
     virtual bool shouldClose() const noexcept = 0;
     virtual void requestClose() noexcept = 0;
 
     virtual std::span<Event> events() const noexcept = 0;
+    virtual std::u32string_view getTextInput() const noexcept = 0;
+    virtual std::string_view getTextInputUtf8() const = 0;
     virtual const NativeInputState* getInput() const noexcept = 0;
 
+    virtual void setIcon(std::span<const IconImage> images) = 0;
+    virtual void applyChanges(const WindowStateChange& changes) = 0;
     virtual void setTitle(const std::string& title) = 0;
     virtual void setSize(int width, int height) = 0;
     virtual void setFocus(bool focus) const noexcept = 0;
     virtual void setVisible(bool visible) const noexcept = 0;
     virtual std::pair<int, int> getSize() const noexcept = 0;
     virtual std::pair<uint32_t, uint32_t> getFrameBufferSize() const noexcept = 0;
+    virtual std::pair<float, float> getContentScale() const noexcept = 0;
+    virtual bool isSurfaceDirty() const noexcept = 0;
+    virtual uint64_t getSurfaceGeneration() const noexcept = 0;
+    virtual std::pair<uint32_t, uint32_t> acknowledgeSurface() noexcept = 0;
+    virtual void setResizeCoalescing(bool enabled) noexcept = 0;
     virtual bool isFocused() const noexcept = 0;
     virtual bool isVisible() const noexcept = 0;
+    virtual double getRefreshRate() const noexcept = 0;
+
+    virtual FrameStats getFrameStats() const noexcept = 0;
+    virtual void resetFrameStats() noexcept = 0;
+
+    virtual WindowId getId() const noexcept = 0;
+    virtual std::shared_ptr<NativeContextGroup> getContextGroup() const noexcept = 0;
+
+    virtual void setCursor(CursorShape shape) = 0;
+    virtual void setCursor(CursorHandle cursor) = 0;
+    virtual void setCursorMode(CursorMode mode) = 0;
+    virtual CursorMode getCursorMode() const noexcept = 0;
+
+    virtual void setClipboard(std::string_view text) = 0;
+    virtual std::string_view getClipboard() = 0;
+    virtual void requestClipboard() = 0;
+
+    virtual void injectEvent(Event event) = 0;
+    // Hide the window and drop per-use state so it can be handed out again
+    virtual void recycle() noexcept = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -99,11 +171,32 @@ class NativeWindowContext
 public:
     virtual ~NativeWindowContext() = default;
 
-    virtual void pollEvents() noexcept = 0;
+    virtual void dispatchPending() noexcept = 0;
+    virtual void clearEvents() noexcept = 0;
+    virtual int getEventFileDescriptor() const noexcept = 0;
+    virtual std::span<const WindowId> getWindowsWithEvents() const noexcept = 0;
+    virtual bool isHeadless() const noexcept = 0;
+    virtual ContextOptions::Platform getPlatform() const noexcept = 0;
+    virtual std::chrono::nanoseconds getInitDuration() const noexcept = 0;
+
+    virtual std::string_view getKeyName(Key key) const = 0;
+    virtual std::string_view getScancodeName(int scancode) const = 0;
+    virtual int getKeyScancode(Key key) const = 0;
+
+    virtual void loadGamepadMappings(const std::filesystem::path& path) = 0;
+
+    virtual CursorHandle createCursor(const CursorImage& image) = 0;
+    // thread-safe
+    virtual void postCommand(NativeWindow& window, WindowCommand::Data command) = 0;
 
     virtual ProcLoader getProcLoader() const = 0;
     virtual bool isVulkanSupported() const = 0;
-    virtual std::vector<std::string> getRequiredVulkanExtensions() const = 0;
+    virtual bool isPresentationSupported(
+        void* instance,
+        void* physicalDevice,
+        uint32_t queueFamily) const noexcept = 0;
+    // backend-owned storage, valid for the lifetime of the context
+    virtual std::span<const char* const> getRequiredVulkanExtensions() const = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -111,7 +204,7 @@ public:
 //----------------------------------------------------------------------------
 namespace factory {
 
-std::unique_ptr<NativeWindowContext> createNativeContext();
+std::unique_ptr<NativeWindowContext> createNativeContext(const ContextOptions& options);
 std::unique_ptr<NativeWindow> createNativeWindow(WindowDesc builder);
 
 }  // namespace factory
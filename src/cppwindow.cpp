@@ -5,7 +5,13 @@
 
 #include <cppwindow/cppwindow.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
 #include "backend/native_impl.hpp"
+#include "vulkan_extensions.hpp"
 
 namespace cwin {
 
@@ -32,6 +38,21 @@ bool InputState::isKeyReleased(Key key) const
     return state_->isKeyReleased(key);
 }
 
+bool InputState::isScancodeDown(int scancode) const
+{
+    return state_->isScancodeDown(scancode);
+}
+
+bool InputState::isScancodePressed(int scancode) const
+{
+    return state_->isScancodePressed(scancode);
+}
+
+bool InputState::isScancodeReleased(int scancode) const
+{
+    return state_->isScancodeReleased(scancode);
+}
+
 bool InputState::isMouseButtonDown(MouseButton button) const
 {
     return state_->isMouseButtonDown(button);
@@ -61,14 +82,15 @@ std::pair<double, double> InputState::getScrollDelta() const
 //  Window Implementation
 //----------------------------------------------------------------------------
 Window::Window(std::unique_ptr<NativeWindow> window)
-    : window_(std::move(window)),
-      inputState_(window->getInput())
+    : inputState_(window->getInput()),
+      window_(std::move(window))
 {
 }
 
 Window::Window(Window&& other) noexcept
-    : window_(std::move(other.window_)),
-      inputState_(std::move(other.inputState_))
+    : inputState_(std::move(other.inputState_)),
+      window_(std::move(other.window_)),
+      framePacer_(other.framePacer_)
 {
 }
 
@@ -79,14 +101,37 @@ NativeHandles Window::getNativeHandles() const
     return window_->getNativeHandles();
 }
 
-VulkanHandle Window::createVulkanSurface(void* instance) const
+VulkanHandle Window::createVulkanSurface(void* instance, const void* allocator) const
 {
-    return window_->createVulkanSurface(instance);
+    return window_->createVulkanSurface(instance, allocator);
+}
+
+int32_t Window::recreateVulkanSurface(
+    void* instance,
+    VulkanHandle& surface,
+    const void* allocator) const noexcept
+{
+    return window_->recreateVulkanSurface(instance, surface, allocator);
 }
 
 void Window::makeContextCurrent()
 {
-    window_->makeContextCurrent();
+    window_->attachContext();
+}
+
+void Window::attachContext()
+{
+    window_->attachContext();
+}
+
+void Window::detachContext()
+{
+    window_->detachContext();
+}
+
+bool Window::isContextCurrent() const noexcept
+{
+    return window_->isContextCurrent();
 }
 
 void Window::swapBuffers()
@@ -114,6 +159,26 @@ const InputState& Window::getInput() const noexcept
     return inputState_;
 }
 
+std::u32string_view Window::getTextInput() const noexcept
+{
+    return window_->getTextInput();
+}
+
+std::string_view Window::getTextInputUtf8() const
+{
+    return window_->getTextInputUtf8();
+}
+
+void Window::setIcon(std::span<const IconImage> images)
+{
+    window_->setIcon(images);
+}
+
+WindowTransaction Window::update()
+{
+    return WindowTransaction(window_.get());
+}
+
 void Window::setTitle(const std::string& title)
 {
     window_->setTitle(title);
@@ -144,6 +209,31 @@ std::pair<uint32_t, uint32_t> Window::getFrameBufferSize() const noexcept
     return window_->getFrameBufferSize();
 }
 
+std::pair<float, float> Window::getContentScale() const noexcept
+{
+    return window_->getContentScale();
+}
+
+bool Window::isSurfaceDirty() const noexcept
+{
+    return window_->isSurfaceDirty();
+}
+
+uint64_t Window::getSurfaceGeneration() const noexcept
+{
+    return window_->getSurfaceGeneration();
+}
+
+std::pair<uint32_t, uint32_t> Window::acknowledgeSurface() noexcept
+{
+    return window_->acknowledgeSurface();
+}
+
+void Window::setResizeCoalescing(bool enabled) noexcept
+{
+    window_->setResizeCoalescing(enabled);
+}
+
 bool Window::isFocused() const noexcept
 {
     return window_->isFocused();
@@ -154,6 +244,121 @@ bool Window::isVisible() const noexcept
     return window_->isVisible();
 }
 
+double Window::getRefreshRate() const noexcept
+{
+    return window_->getRefreshRate();
+}
+
+FramePacer& Window::getFramePacer() noexcept
+{
+    return framePacer_;
+}
+
+FrameStats Window::getFrameStats() const noexcept
+{
+    return window_->getFrameStats();
+}
+
+void Window::resetFrameStats() noexcept
+{
+    window_->resetFrameStats();
+}
+
+WindowId Window::getId() const noexcept
+{
+    return window_->getId();
+}
+
+bool Window::sharesContextWith(const Window& other) const noexcept
+{
+    auto group = window_->getContextGroup();
+    return group && group == other.window_->getContextGroup();
+}
+
+void Window::setCursor(CursorShape shape)
+{
+    window_->setCursor(shape);
+}
+
+void Window::setCursor(CursorHandle cursor)
+{
+    window_->setCursor(cursor);
+}
+
+void Window::setCursorMode(CursorMode mode)
+{
+    window_->setCursorMode(mode);
+}
+
+CursorMode Window::getCursorMode() const noexcept
+{
+    return window_->getCursorMode();
+}
+
+void Window::setClipboard(std::string_view text)
+{
+    window_->setClipboard(text);
+}
+
+std::string_view Window::getClipboard()
+{
+    return window_->getClipboard();
+}
+
+void Window::requestClipboard()
+{
+    window_->requestClipboard();
+}
+
+void Window::injectEvent(const Event& event)
+{
+    window_->injectEvent(event);
+}
+
+//----------------------------------------------------------------------------
+//  Window Transaction Implementation
+//----------------------------------------------------------------------------
+WindowTransaction::WindowTransaction(NativeWindow* window)
+    : window_(window)
+{
+}
+
+WindowTransaction& WindowTransaction::title(std::string t)
+{
+    changes_.title = std::move(t);
+    return *this;
+}
+
+WindowTransaction& WindowTransaction::size(int w, int h)
+{
+    changes_.size = { w, h };
+    return *this;
+}
+
+WindowTransaction& WindowTransaction::position(int x, int y)
+{
+    changes_.position = { x, y };
+    return *this;
+}
+
+WindowTransaction& WindowTransaction::visible(bool v)
+{
+    changes_.visible = v;
+    return *this;
+}
+
+WindowTransaction& WindowTransaction::decorated(bool d)
+{
+    changes_.decorated = d;
+    return *this;
+}
+
+void WindowTransaction::commit()
+{
+    window_->applyChanges(changes_);
+    changes_ = {};
+}
+
 //----------------------------------------------------------------------------
 //  Window Builder Implementation
 //----------------------------------------------------------------------------
@@ -167,12 +372,18 @@ struct WindowBuilder::Data
     bool visible = true;
     bool decorated = true;
     bool focused = true;
+    bool scaleToMonitor = false;
+    bool scaleFramebuffer = true;
+    bool coalesceResize = false;
+    std::shared_ptr<NativeContextGroup> contextGroup{};
 };
 
 WindowBuilder::WindowBuilder()
     : data_(std::make_unique<Data>()) {};
 
 WindowBuilder::~WindowBuilder() = default;
+WindowBuilder::WindowBuilder(WindowBuilder&&) noexcept = default;
+WindowBuilder& WindowBuilder::operator=(WindowBuilder&&) noexcept = default;
 
 WindowBuilder& WindowBuilder::title(std::string t)
 {
@@ -220,8 +431,39 @@ WindowBuilder& WindowBuilder::borderless()
     return *this;
 }
 
+WindowBuilder& WindowBuilder::scaleToMonitor()
+{
+    data_->scaleToMonitor = true;
+    return *this;
+}
+
+WindowBuilder& WindowBuilder::scaleFramebuffer(bool enabled)
+{
+    data_->scaleFramebuffer = enabled;
+    return *this;
+}
+
+WindowBuilder& WindowBuilder::coalesceResizeEvents()
+{
+    data_->coalesceResize = true;
+    return *this;
+}
+
+WindowBuilder& WindowBuilder::shareContextWith(const Window& window)
+{
+    auto group = window.window_->getContextGroup();
+    if (!group) {
+        throw std::invalid_argument("Cannot share context with a window without OpenGL context");
+    }
+    data_->contextGroup = std::move(group);
+    return *this;
+}
+
 Window WindowBuilder::build()
 {
+    if (data_->contextGroup && !std::holds_alternative<OpenGLGraphicsModeTag>(data_->mode)) {
+        throw std::invalid_argument("Shared context requires an OpenGL window");
+    }
     WindowDesc desc{
         .mode = data_->mode,
         .title = data_->title,
@@ -231,32 +473,242 @@ Window WindowBuilder::build()
         .visible = data_->visible,
         .decorated = data_->decorated,
         .focused = data_->focused,
+        .scaleToMonitor = data_->scaleToMonitor,
+        .scaleFramebuffer = data_->scaleFramebuffer,
+        .coalesceResize = data_->coalesceResize,
+        .contextGroup = data_->contextGroup,
     };
     auto native = factory::createNativeWindow(std::move(desc));
     return Window(std::move(native));
 }
 
+//----------------------------------------------------------------------------
+//  Render Thread Implementation
+//----------------------------------------------------------------------------
+RenderThread::RenderThread(Window& window, std::function<void(std::stop_token)> render)
+{
+    // the native window stays put even if the Window wrapper is moved
+    NativeWindow* native = window.window_.get();
+    native->detachContext();
+
+    thread_ = std::jthread([this, native, render = std::move(render)](std::stop_token token) {
+        try {
+            native->attachContext();
+            render(token);
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+        native->detachContext();
+    });
+}
+
+RenderThread::~RenderThread()
+{
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+}
+
+void RenderThread::requestStop() noexcept
+{
+    thread_.request_stop();
+}
+
+void RenderThread::join()
+{
+    thread_.join();
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+bool RenderThread::joinable() const noexcept
+{
+    return thread_.joinable();
+}
+
+//----------------------------------------------------------------------------
+//  Window Pool Implementation
+//----------------------------------------------------------------------------
+WindowPool::WindowPool(WindowBuilder prototype, size_t count)
+    : prototype_(std::move(prototype))
+{
+    prototype_.hidden();
+    windows_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        windows_.push_back(build());
+    }
+}
+
+WindowPool::~WindowPool() = default;
+WindowPool::WindowPool(WindowPool&&) noexcept = default;
+WindowPool& WindowPool::operator=(WindowPool&&) noexcept = default;
+
+Window WindowPool::acquire(const std::string& title, int width, int height)
+{
+    if (windows_.empty()) {
+        windows_.push_back(build());
+    }
+    Window window = std::move(windows_.back());
+    windows_.pop_back();
+
+    window.window_->setTitle(title);
+    window.window_->setSize(width, height);
+    window.window_->setVisible(true);
+    window.framePacer_.reset();
+    return window;
+}
+
+void WindowPool::release(Window&& window)
+{
+    // a foreign window would be hidden and handed to the next acquire()
+    // with another window's settings
+    const bool pooled = window.window_
+        && std::find(members_.begin(), members_.end(), window.window_->getId()) != members_.end();
+    if (!pooled) {
+        throw std::invalid_argument("Window was not created by this pool");
+    }
+    window.window_->recycle();
+    windows_.push_back(std::move(window));
+}
+
+Window WindowPool::build()
+{
+    Window window = prototype_.build();
+    members_.push_back(window.window_->getId());
+    return window;
+}
+
+size_t WindowPool::available() const noexcept
+{
+    return windows_.size();
+}
+
 //----------------------------------------------------------------------------
 //  Window Context Implemenation
 //----------------------------------------------------------------------------
+namespace {
+
+std::unique_ptr<WindowContext> g_Context;
+
+}  // namespace
+
+WindowContext& WindowContext::initialize(const ContextOptions& options)
+{
+    if (g_Context) {
+        throw std::logic_error("WindowContext is already initialized");
+    }
+    g_Context.reset(new WindowContext(options));
+    return *g_Context;
+}
+
 WindowContext& WindowContext::Get()
 {
     // init context
-    static WindowContext instance;
-    return instance;
+    if (!g_Context) {
+        return initialize();
+    }
+    return *g_Context;
 }
 
-WindowContext::WindowContext()
+WindowContext::WindowContext(const ContextOptions& options)
 {
     context_.reset();
-    context_ = factory::createNativeContext();
+    context_ = factory::createNativeContext(options);
 }
 
 WindowContext::~WindowContext() = default;
 
 void WindowContext::pollEvents() const noexcept
 {
-    context_->pollEvents();
+    context_->clearEvents();
+    context_->dispatchPending();
+}
+
+void WindowContext::dispatchPending() const noexcept
+{
+    context_->dispatchPending();
+}
+
+void WindowContext::clearEvents() const noexcept
+{
+    context_->clearEvents();
+}
+
+int WindowContext::getEventFileDescriptor() const noexcept
+{
+    return context_->getEventFileDescriptor();
+}
+
+std::span<const WindowId> WindowContext::getWindowsWithEvents() const noexcept
+{
+    return context_->getWindowsWithEvents();
+}
+
+bool WindowContext::isHeadless() const noexcept
+{
+    return context_->isHeadless();
+}
+
+ContextOptions::Platform WindowContext::getPlatform() const noexcept
+{
+    return context_->getPlatform();
+}
+
+std::chrono::nanoseconds WindowContext::getInitDuration() const noexcept
+{
+    return context_->getInitDuration();
+}
+
+WindowPool WindowContext::createWindowPool(WindowBuilder prototype, size_t count) const
+{
+    return WindowPool(std::move(prototype), count);
+}
+
+void WindowContext::postSetTitle(const Window& window, std::string title)
+{
+    context_->postCommand(*window.window_, WindowCommand::SetTitle{ .title = std::move(title) });
+}
+
+void WindowContext::postSetSize(const Window& window, int width, int height)
+{
+    context_->postCommand(
+        *window.window_,
+        WindowCommand::SetSize{
+            .width = width,
+            .height = height,
+        });
+}
+
+void WindowContext::postSetVisible(const Window& window, bool visible)
+{
+    context_->postCommand(*window.window_, WindowCommand::SetVisible{ .visible = visible });
+}
+
+std::string_view WindowContext::getKeyName(Key key) const
+{
+    return context_->getKeyName(key);
+}
+
+std::string_view WindowContext::getScancodeName(int scancode) const
+{
+    return context_->getScancodeName(scancode);
+}
+
+int WindowContext::getKeyScancode(Key key) const
+{
+    return context_->getKeyScancode(key);
+}
+
+void WindowContext::loadGamepadMappings(const std::filesystem::path& path)
+{
+    context_->loadGamepadMappings(path);
+}
+
+CursorHandle WindowContext::createCursor(const CursorImage& image)
+{
+    return context_->createCursor(image);
 }
 
 ProcLoader WindowContext::getProcLoader() const
@@ -269,9 +721,30 @@ bool WindowContext::isVulkanSupported() const
     return context_->isVulkanSupported();
 }
 
+bool WindowContext::isPresentationSupported(
+    void* instance,
+    void* physicalDevice,
+    uint32_t queueFamily) const noexcept
+{
+    return context_->isPresentationSupported(instance, physicalDevice, queueFamily);
+}
+
 std::vector<std::string> WindowContext::getRequiredGlfwVulkanExtensions() const
+{
+    std::span<const char* const> extensions = context_->getRequiredVulkanExtensions();
+    return std::vector<std::string>(extensions.begin(), extensions.end());
+}
+
+std::span<const char* const> WindowContext::getRequiredVulkanInstanceExtensions() const
 {
     return context_->getRequiredVulkanExtensions();
 }
 
+size_t WindowContext::mergeVulkanExtensions(
+    std::span<const char* const> requested,
+    std::span<const char*> out) const
+{
+    return vulkan::mergeExtensions(context_->getRequiredVulkanExtensions(), requested, out);
+}
+
 }  // namespace cwin
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_FRAME_ARENA_HPP
+#define CPPWINDOW_HEADER_FRAME_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace cwin {
+
+// Bump allocator for event payloads that only live until the next poll.
+// Memory comes from a list of chunks that are rewound, not freed, on reset,
+// so a steady workload stops allocating after the first few frames.
+class FrameArena
+{
+public:
+    static constexpr size_t DefaultChunkSize = 4096;
+
+    FrameArena() = default;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    // chunks are heap blocks, handed out memory survives a move
+    FrameArena(FrameArena&&) noexcept = default;
+    FrameArena& operator=(FrameArena&&) noexcept = default;
+
+    // Uninitialized storage for `count` objects of trivially destructible T
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+    }
+
+    // Invalidates everything handed out so far
+    void reset() noexcept
+    {
+        current_ = 0;
+        offset_ = 0;
+    }
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    void* allocateBytes(size_t size, size_t align)
+    {
+        while (current_ < chunks_.size()) {
+            Chunk& chunk = chunks_[current_];
+            uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+            size_t aligned = ((base + offset_ + align - 1) & ~(align - 1)) - base;
+            if (aligned + size <= chunk.size) {
+                offset_ = aligned + size;
+                return chunk.data.get() + aligned;
+            }
+            ++current_;
+            offset_ = 0;
+        }
+
+        // oversized requests get a chunk of their own
+        size_t chunkSize = std::max(DefaultChunkSize, size + align);
+        chunks_.push_back(Chunk{ std::make_unique<std::byte[]>(chunkSize), chunkSize });
+        current_ = chunks_.size() - 1;
+        offset_ = 0;
+        return allocateBytes(size, align);
+    }
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+};
+
+}  // namespace cwin
+
+#endif
\ No newline at end of file
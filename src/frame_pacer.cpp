@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include <cppwindow/cppwindow.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace cwin {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Sleep overshoot is typically well below a millisecond on Linux and macOS,
+// Windows timers may still be at their default 1ms+ resolution.
+#if defined(CPPWINDOW_PLATFORM_WINDOWS)
+constexpr FramePacer::Clock::duration InitialSleepMargin = 2ms;
+#else
+constexpr FramePacer::Clock::duration InitialSleepMargin = 1ms;
+#endif
+constexpr FramePacer::Clock::duration MinSleepMargin = 100us;
+constexpr FramePacer::Clock::duration MaxSleepMargin = 4ms;
+
+}  // namespace
+
+//----------------------------------------------------------------------------
+//  Frame Pacer Implementation
+//----------------------------------------------------------------------------
+FramePacer::FramePacer(double targetRate) noexcept
+    : sleepMargin_(InitialSleepMargin)
+{
+    setTargetRate(targetRate);
+}
+
+void FramePacer::setTargetRate(double rate) noexcept
+{
+    if (rate > 0.0) {
+        period_ = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+    } else {
+        period_ = Clock::duration::zero();
+    }
+    reset();
+}
+
+double FramePacer::getTargetRate() const noexcept
+{
+    if (period_ <= Clock::duration::zero()) {
+        return 0.0;
+    }
+    return 1.0 / std::chrono::duration<double>(period_).count();
+}
+
+void FramePacer::reset() noexcept
+{
+    deadline_ = {};
+    lastFrame_ = {};
+    missedDeadlines_ = 0;
+    missedLast_ = false;
+}
+
+std::chrono::duration<double> FramePacer::waitForNextFrame() noexcept
+{
+    Clock::time_point now = Clock::now();
+
+    // first frame, nothing to wait for
+    if (lastFrame_ == Clock::time_point{}) {
+        lastFrame_ = now;
+        deadline_ = now + period_;
+        return Clock::duration::zero();
+    }
+
+    if (period_ > Clock::duration::zero()) {
+        // the frame took longer than a period
+        bool missed = now > deadline_;
+        if (!missed) {
+            Clock::time_point wakeUp = deadline_ - sleepMargin_;
+            if (now < wakeUp) {
+                std::this_thread::sleep_until(wakeUp);
+                now = Clock::now();
+                calibrate(now - wakeUp);
+                // overslept past the deadline, as late as a slow frame
+                missed = now > deadline_;
+            }
+            // spin out the remaining margin
+            while (now < deadline_) {
+                now = Clock::now();
+            }
+        }
+        if (missed) {
+            // restart the cadence from here instead of trying to catch up
+            ++missedDeadlines_;
+            deadline_ = now;
+        }
+        missedLast_ = missed;
+        deadline_ += period_;
+    }
+
+    std::chrono::duration<double> delta = now - lastFrame_;
+    lastFrame_ = now;
+    return delta;
+}
+
+void FramePacer::calibrate(Clock::duration overshoot) noexcept
+{
+    // grow immediately on a late wake-up, shrink slowly otherwise so that
+    // the margin tracks the worst recent overshoot rather than the mean
+    if (overshoot > sleepMargin_) {
+        sleepMargin_ = overshoot + overshoot / 4;
+    } else {
+        sleepMargin_ -= (sleepMargin_ - overshoot) / 16;
+    }
+    sleepMargin_ = std::clamp(sleepMargin_, MinSleepMargin, MaxSleepMargin);
+}
+
+FramePacer::Clock::duration FramePacer::getSleepMargin() const noexcept
+{
+    return sleepMargin_;
+}
+
+uint64_t FramePacer::getMissedDeadlines() const noexcept
+{
+    return missedDeadlines_;
+}
+
+bool FramePacer::missedLastDeadline() const noexcept
+{
+    return missedLast_;
+}
+
+}  // namespace cwin
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(CPPWINDOW_PLATFORM_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cwin {
+
+//----------------------------------------------------------------------------
+//  Mapped File Implementation
+//----------------------------------------------------------------------------
+#if defined(CPPWINDOW_PLATFORM_WINDOWS)
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to query the size of " + path.string());
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    // empty files cannot be mapped, there is nothing to read anyway
+    if (size_ == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // the view keeps the mapping and the file alive
+    CloseHandle(file);
+    if (!mapping) {
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+    data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (!data_) {
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+}
+
+void MappedFile::release() noexcept
+{
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to query the size of " + path.string());
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    // empty files cannot be mapped, there is nothing to read anyway
+    if (size_ == 0) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    if (data == MAP_FAILED) {
+        size_ = 0;
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+    data_ = static_cast<const char*>(data);
+}
+
+void MappedFile::release() noexcept
+{
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+std::string_view MappedFile::data() const noexcept
+{
+    return data_ ? std::string_view(data_, size_) : std::string_view{};
+}
+
+}  // namespace cwin
\ No newline at end of file
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_MAPPED_FILE_HPP
+#define CPPWINDOW_HEADER_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace cwin {
+
+// Read-only memory mapping of a whole file. Pages are loaded by the OS on
+// first access, so only the parts that are actually read cost any I/O.
+class MappedFile
+{
+public:
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    std::string_view data() const noexcept;
+
+private:
+    void release() noexcept;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace cwin
+
+#endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_MPSC_QUEUE_HPP
+#define CPPWINDOW_HEADER_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace cwin {
+
+// Lock-free multi-producer single-consumer queue. Producers push onto an
+// atomic list head, the consumer takes the whole list with one exchange and
+// reverses it, so there is no ABA hazard and no lock on either side.
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue()
+    {
+        drain([](T&) {});
+    }
+
+    // Safe to call from any thread
+    void push(T value)
+    {
+        Node* node = new Node{ std::move(value), head_.load(std::memory_order_relaxed) };
+        while (!head_.compare_exchange_weak(
+            node->next,
+            node,
+            std::memory_order_release,
+            std::memory_order_relaxed)) {
+        }
+    }
+
+    // Consumer only, visits every queued value in push order
+    template <typename Fn>
+    void drain(Fn&& fn)
+    {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        if (!node) {
+            return;
+        }
+
+        // the list is newest first, reverse it to get push order
+        Node* ordered = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        while (ordered) {
+            Node* next = ordered->next;
+            fn(ordered->value);
+            delete ordered;
+            ordered = next;
+        }
+    }
+
+private:
+    struct Node
+    {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_{ nullptr };
+};
+
+}  // namespace cwin
+
+#endif
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "pixel_convert.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPPWINDOW_PIXELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define CPPWINDOW_PIXELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace cwin::pixels {
+
+namespace {
+
+bool isBGRA(PixelFormat format) noexcept
+{
+    return format == PixelFormat::BGRA8 || format == PixelFormat::BGRA8Premultiplied;
+}
+
+bool isPremultiplied(PixelFormat format) noexcept
+{
+    return format == PixelFormat::RGBA8Premultiplied || format == PixelFormat::BGRA8Premultiplied;
+}
+
+uint8_t unpremultiply(uint8_t color, uint8_t alpha) noexcept
+{
+    if (alpha == 0) {
+        return 0;
+    }
+    unsigned value = (color * 255u + alpha / 2u) / alpha;
+    return static_cast<uint8_t>(std::min(value, 255u));
+}
+
+// Reference for the vector kernels, also handles whatever they leave over
+void convertScalar(const uint8_t* src, uint8_t* dst, size_t count, PixelFormat format) noexcept
+{
+    bool swap = isBGRA(format);
+    bool premultiplied = isPremultiplied(format);
+    for (size_t i = 0; i < count; ++i, src += 4, dst += 4) {
+        uint8_t r = swap ? src[2] : src[0];
+        uint8_t g = src[1];
+        uint8_t b = swap ? src[0] : src[2];
+        uint8_t a = src[3];
+        if (premultiplied) {
+            r = unpremultiply(r, a);
+            g = unpremultiply(g, a);
+            b = unpremultiply(b, a);
+        }
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+        dst[3] = a;
+    }
+}
+
+#if defined(CPPWINDOW_PIXELS_SSE2)
+
+// swaps bytes 0 and 2 of every 32-bit lane
+inline __m128i swapRedBlue(__m128i px) noexcept
+{
+    const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+    __m128i rb = _mm_and_si128(px, rbMask);
+    __m128i ga = _mm_andnot_si128(rbMask, px);
+    __m128i swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+    return _mm_or_si128(ga, _mm_and_si128(swapped, rbMask));
+}
+
+// one pixel per register as 4 x int32, colour channels divided by alpha
+// with the same rounding as unpremultiply(): (c * 255 + a / 2) / a
+inline __m128i unpremultiplyPixel(__m128i px) noexcept
+{
+    // keep the alpha lane as is
+    const __m128i alphaLane = _mm_set_epi32(-1, 0, 0, 0);
+
+    __m128i alpha = _mm_shuffle_epi32(px, _MM_SHUFFLE(3, 3, 3, 3));
+    // c * 255 + a / 2 stays below 2^16, exact in float
+    __m128i numerator = _mm_sub_epi32(_mm_slli_epi32(px, 8), px);
+    numerator = _mm_add_epi32(numerator, _mm_srli_epi32(alpha, 1));
+    __m128 alphaF = _mm_cvtepi32_ps(alpha);
+    // the division is correctly rounded and a fractional quotient is at
+    // least 1/255 away from the next integer, so truncating is exact
+    __m128 quotient = _mm_div_ps(_mm_cvtepi32_ps(numerator), alphaF);
+    __m128i result = _mm_cvttps_epi32(_mm_min_ps(quotient, _mm_set1_ps(255.0f)));
+    // alpha == 0 divides by zero, zero those pixels
+    result = _mm_and_si128(result, _mm_castps_si128(_mm_cmpneq_ps(alphaF, _mm_setzero_ps())));
+    return _mm_or_si128(_mm_andnot_si128(alphaLane, result), _mm_and_si128(alphaLane, px));
+}
+
+size_t convertSimd(const uint8_t* src, uint8_t* dst, size_t count, PixelFormat format) noexcept
+{
+    bool swap = isBGRA(format);
+    bool premultiplied = isPremultiplied(format);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        if (premultiplied) {
+            __m128i lo = _mm_unpacklo_epi8(px, zero);
+            __m128i hi = _mm_unpackhi_epi8(px, zero);
+            __m128i p0 = unpremultiplyPixel(_mm_unpacklo_epi16(lo, zero));
+            __m128i p1 = unpremultiplyPixel(_mm_unpackhi_epi16(lo, zero));
+            __m128i p2 = unpremultiplyPixel(_mm_unpacklo_epi16(hi, zero));
+            __m128i p3 = unpremultiplyPixel(_mm_unpackhi_epi16(hi, zero));
+            px = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        }
+        if (swap) {
+            px = swapRedBlue(px);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), px);
+    }
+    return i;
+}
+
+#elif defined(CPPWINDOW_PIXELS_NEON)
+
+inline float32x4_t alphaInverse(uint16x4_t alpha)
+{
+    float32x4_t a = vcvtq_f32_u32(vmovl_u16(alpha));
+    // reciprocal estimate refined twice, divideRounded fixes the last bit
+    float32x4_t inv = vrecpeq_f32(a);
+    inv = vmulq_f32(vrecpsq_f32(a, inv), inv);
+    return vmulq_f32(vrecpsq_f32(a, inv), inv);
+}
+
+// numerator / alpha rounded down, clamped to 255
+inline uint32x4_t divideRounded(uint32x4_t numerator, uint32x4_t alpha, float32x4_t inverse)
+{
+    uint32x4_t q = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(numerator), inverse));
+    // the reciprocal is not exact, so the quotient may be one off either way
+    int32x4_t remainder = vreinterpretq_s32_u32(vmlsq_u32(numerator, q, alpha));
+    q = vaddq_u32(q, vcltq_s32(remainder, vdupq_n_s32(0)));
+    q = vsubq_u32(q, vcgeq_s32(remainder, vreinterpretq_s32_u32(alpha)));
+    return vminq_u32(q, vdupq_n_u32(255));
+}
+
+// same rounding as unpremultiply(): (c * 255 + a / 2) / a
+inline uint8x8_t unpremultiplyChannel(
+    uint8x8_t color,
+    uint16x8_t alpha,
+    float32x4_t inverseLo,
+    float32x4_t inverseHi)
+{
+    // c * 255 + a / 2 stays below 2^16
+    uint16x8_t wide = vmovl_u8(color);
+    uint16x8_t numerator = vaddq_u16(vsubq_u16(vshlq_n_u16(wide, 8), wide), vshrq_n_u16(alpha, 1));
+    uint32x4_t lo = divideRounded(
+        vmovl_u16(vget_low_u16(numerator)),
+        vmovl_u16(vget_low_u16(alpha)),
+        inverseLo);
+    uint32x4_t hi = divideRounded(
+        vmovl_u16(vget_high_u16(numerator)),
+        vmovl_u16(vget_high_u16(alpha)),
+        inverseHi);
+    uint16x8_t result = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+    // alpha == 0 divides by zero, zero those pixels
+    result = vandq_u16(result, vmvnq_u16(vceqq_u16(alpha, vdupq_n_u16(0))));
+    return vmovn_u16(result);
+}
+
+size_t convertSimd(const uint8_t* src, uint8_t* dst, size_t count, PixelFormat format) noexcept
+{
+    bool swap = isBGRA(format);
+    bool premultiplied = isPremultiplied(format);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // de-interleaves into one register per channel
+        uint8x8x4_t px = vld4_u8(src + i * 4);
+        if (swap) {
+            uint8x8_t tmp = px.val[0];
+            px.val[0] = px.val[2];
+            px.val[2] = tmp;
+        }
+        if (premultiplied) {
+            uint16x8_t alpha = vmovl_u8(px.val[3]);
+            float32x4_t inverseLo = alphaInverse(vget_low_u16(alpha));
+            float32x4_t inverseHi = alphaInverse(vget_high_u16(alpha));
+            for (int c = 0; c < 3; ++c) {
+                px.val[c] = unpremultiplyChannel(px.val[c], alpha, inverseLo, inverseHi);
+            }
+        }
+        vst4_u8(dst + i * 4, px);
+    }
+    return i;
+}
+
+#else
+
+size_t convertSimd(const uint8_t*, uint8_t*, size_t, PixelFormat) noexcept
+{
+    return 0;
+}
+
+#endif
+
+}  // namespace
+
+void convertToRGBA8(std::span<const uint8_t> src, std::span<uint8_t> dst, PixelFormat format)
+{
+    size_t count = std::min(src.size(), dst.size()) / 4;
+    if (format == PixelFormat::RGBA8) {
+        std::memcpy(dst.data(), src.data(), count * 4);
+        return;
+    }
+    size_t done = convertSimd(src.data(), dst.data(), count, format);
+    convertScalar(src.data() + done * 4, dst.data() + done * 4, count - done, format);
+}
+
+void convertToRGBA8Scalar(
+    std::span<const uint8_t> src,
+    std::span<uint8_t> dst,
+    PixelFormat format) noexcept
+{
+    size_t count = std::min(src.size(), dst.size()) / 4;
+    convertScalar(src.data(), dst.data(), count, format);
+}
+
+uint64_t hash(std::span<const uint8_t> bytes, uint64_t seed) noexcept
+{
+    // multiply-xorshift over 8-byte words, good spread at memory speed
+    constexpr uint64_t Prime = 0x9E3779B97F4A7C15ull;
+    uint64_t h = seed ^ (bytes.size() * Prime);
+
+    size_t i = 0;
+    for (; i + 8 <= bytes.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + i, sizeof(word));
+        h = (h ^ word) * Prime;
+        h ^= h >> 32;
+    }
+    if (i < bytes.size()) {
+        uint64_t tail = 0;
+        std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+        h = (h ^ tail) * Prime;
+    }
+    h ^= h >> 29;
+    return h;
+}
+
+}  // namespace cwin::pixels
\ No newline at end of file
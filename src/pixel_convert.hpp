@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_PIXEL_CONVERT_HPP
+#define CPPWINDOW_HEADER_PIXEL_CONVERT_HPP
+
+#include <cppwindow/cppwindow.hpp>
+
+#include <cstdint>
+#include <span>
+
+namespace cwin::pixels {
+
+// Converts `src` (4 bytes per pixel in `format`) to straight RGBA8 in `dst`.
+// Both spans must hold the same number of whole pixels.
+void convertToRGBA8(std::span<const uint8_t> src, std::span<uint8_t> dst, PixelFormat format);
+
+// Portable conversion the vector kernels must match bit for bit
+void convertToRGBA8Scalar(
+    std::span<const uint8_t> src,
+    std::span<uint8_t> dst,
+    PixelFormat format) noexcept;
+
+// 64-bit content hash used to key converted image caches
+uint64_t hash(std::span<const uint8_t> bytes, uint64_t seed) noexcept;
+
+}  // namespace cwin::pixels
+
+#endif
\ No newline at end of file
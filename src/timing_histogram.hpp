@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_TIMING_HISTOGRAM_HPP
+#define CPPWINDOW_HEADER_TIMING_HISTOGRAM_HPP
+
+#include <cppwindow/cppwindow.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+namespace cwin {
+
+// Rolling histogram over the last `WindowSize` samples. Buckets are
+// log-linear (8 per power of two, microsecond resolution), so percentiles
+// are accurate to ~12% while all storage stays fixed-size. Safe to record
+// on one thread (e.g. a render thread swapping buffers) while another
+// summarizes or clears: each call holds a spinlock for at most a few
+// microseconds.
+class TimingHistogram
+{
+public:
+    static constexpr size_t WindowSize = 512;
+    static constexpr uint32_t SubBucketBits = 3;
+    static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+    // values below 8us get one bucket each, every power of two above that
+    // gets SubBucketCount, so the last bucket starts at 15 * 2^22us (~63s)
+    // and also takes anything longer
+    static constexpr size_t BucketCount = 24 * SubBucketCount;
+
+    void record(std::chrono::nanoseconds duration) noexcept
+    {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        uint32_t value = static_cast<uint32_t>(std::clamp<int64_t>(micros, 0, UINT32_MAX));
+
+        Guard guard(lock_);
+
+        if (size_ == WindowSize) {
+            // evict the oldest sample
+            --counts_[bucketOf(samples_[head_])];
+        } else {
+            ++size_;
+        }
+        samples_[head_] = value;
+        ++counts_[bucketOf(value)];
+        head_ = (head_ + 1) % WindowSize;
+    }
+
+    void clear() noexcept
+    {
+        Guard guard(lock_);
+        counts_.fill(0);
+        head_ = 0;
+        size_ = 0;
+    }
+
+    TimingPercentiles summarize() const noexcept
+    {
+        Guard guard(lock_);
+        TimingPercentiles result{};
+        result.samples = static_cast<uint32_t>(size_);
+        if (size_ == 0) {
+            return result;
+        }
+
+        uint32_t maxValue = 0;
+        for (size_t i = 0; i < size_; ++i) {
+            maxValue = std::max(maxValue, samples_[i]);
+        }
+        result.max = toDuration(maxValue);
+        result.p50 = percentile(0.50, maxValue);
+        result.p95 = percentile(0.95, maxValue);
+        result.p99 = percentile(0.99, maxValue);
+        return result;
+    }
+
+private:
+    class Guard
+    {
+    public:
+        explicit Guard(std::atomic_flag& flag) noexcept
+            : flag_(flag)
+        {
+            while (flag_.test_and_set(std::memory_order_acquire)) {
+                // spin on a plain load, not on the read-modify-write
+                while (flag_.test(std::memory_order_relaxed)) {
+                }
+            }
+        }
+
+        ~Guard()
+        {
+            flag_.clear(std::memory_order_release);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        std::atomic_flag& flag_;
+    };
+
+    static constexpr size_t bucketOf(uint32_t micros) noexcept
+    {
+        if (micros < SubBucketCount) {
+            return micros;
+        }
+        uint32_t exponent = std::bit_width(micros) - 1;
+        uint32_t mantissa = (micros >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+        size_t idx = (exponent - SubBucketBits + 1) * SubBucketCount + mantissa;
+        return std::min(idx, BucketCount - 1);
+    }
+
+    // smallest value that falls into the bucket after `bucket`
+    static constexpr uint32_t upperBoundOf(size_t bucket) noexcept
+    {
+        if (bucket < SubBucketCount) {
+            return static_cast<uint32_t>(bucket) + 1;
+        }
+        uint32_t exponent = static_cast<uint32_t>(bucket / SubBucketCount) + SubBucketBits - 1;
+        uint32_t mantissa = static_cast<uint32_t>(bucket % SubBucketCount);
+        return (SubBucketCount + mantissa + 1) << (exponent - SubBucketBits);
+    }
+
+    static TimingPercentiles::Duration toDuration(uint32_t micros) noexcept
+    {
+        return std::chrono::duration<double, std::micro>(micros);
+    }
+
+    TimingPercentiles::Duration percentile(double fraction, uint32_t maxValue) const noexcept
+    {
+        auto rank = static_cast<size_t>(fraction * static_cast<double>(size_ - 1)) + 1;
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < BucketCount; ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                // report the bucket's exclusive upper bound, so percentiles
+                // err on the slow side, but never more than the largest
+                // sample we actually saw
+                return toDuration(std::min(upperBoundOf(bucket), maxValue));
+            }
+        }
+        return toDuration(maxValue);
+    }
+
+    std::array<uint32_t, BucketCount> counts_{};
+    std::array<uint32_t, WindowSize> samples_{};
+    size_t head_ = 0;
+    size_t size_ = 0;
+    mutable std::atomic_flag lock_;
+};
+
+}  // namespace cwin
+
+#endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "utf_transcode.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPPWINDOW_UTF_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cwin::utf {
+
+namespace {
+
+constexpr char32_t ReplacementCharacter = 0xFFFD;
+
+// Writes one code point and returns the number of bytes used
+size_t encode(char32_t c, char* out) noexcept
+{
+    if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+        c = ReplacementCharacter;
+    }
+    if (c < 0x80) {
+        out[0] = static_cast<char>(c);
+        return 1;
+    }
+    if (c < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (c >> 6));
+        out[1] = static_cast<char>(0x80 | (c & 0x3F));
+        return 2;
+    }
+    if (c < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (c >> 12));
+        out[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (c & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (c >> 18));
+    out[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (c & 0x3F));
+    return 4;
+}
+
+#if defined(CPPWINDOW_UTF_SSE2)
+
+// Narrows runs of ASCII 8 code points at a time, stops at the first block
+// containing anything wider and returns how many code points it consumed
+size_t narrowAscii(const char32_t* src, size_t count, char* out) noexcept
+{
+    const __m128i highBits = _mm_set1_epi32(~0x7F);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        __m128i wide = _mm_and_si128(_mm_or_si128(a, b), highBits);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(wide, _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+        // every lane is below 0x80, so the saturating packs are exact
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+    return i;
+}
+
+#else
+
+size_t narrowAscii(const char32_t*, size_t, char*) noexcept
+{
+    return 0;
+}
+
+#endif
+
+}  // namespace
+
+void appendUtf8(std::u32string_view src, std::vector<char>& dst)
+{
+    size_t start = dst.size();
+    // worst case, shrunk to the real length below
+    dst.resize(start + src.size() * 4);
+    char* out = dst.data() + start;
+
+    size_t i = 0;
+    while (i < src.size()) {
+        size_t ascii = narrowAscii(src.data() + i, src.size() - i, out);
+        i += ascii;
+        out += ascii;
+        if (i == src.size()) {
+            break;
+        }
+        // the block that stopped the fast path, or the tail
+        size_t end = std::min(i + 8, src.size());
+        for (; i < end; ++i) {
+            out += encode(src[i], out);
+        }
+    }
+    dst.resize(static_cast<size_t>(out - dst.data()));
+}
+
+}  // namespace cwin::utf
\ No newline at end of file
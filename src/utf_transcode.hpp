@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_UTF_TRANSCODE_HPP
+#define CPPWINDOW_HEADER_UTF_TRANSCODE_HPP
+
+#include <string_view>
+#include <vector>
+
+namespace cwin::utf {
+
+// Appends `src` encoded as UTF-8 to `dst`. Surrogates and values beyond
+// U+10FFFF are replaced with U+FFFD.
+void appendUtf8(std::u32string_view src, std::vector<char>& dst);
+
+}  // namespace cwin::utf
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "vulkan_extensions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace cwin::vulkan {
+
+size_t mergeExtensions(
+    std::span<const char* const> required,
+    std::span<const char* const> requested,
+    std::span<const char*> out)
+{
+    if (required.size() > out.size()) {
+        throw std::out_of_range("Buffer too small for the required Vulkan extensions");
+    }
+    std::copy(required.begin(), required.end(), out.begin());
+
+    // extension lists are a handful of entries, a linear scan beats hashing
+    size_t count = required.size();
+    for (const char* name : requested) {
+        auto merged = out.first(count);
+        bool present = std::any_of(merged.begin(), merged.end(), [name](const char* existing) {
+            return std::strcmp(existing, name) == 0;
+        });
+        if (present) {
+            continue;
+        }
+        if (count == out.size()) {
+            throw std::out_of_range("Buffer too small for the merged Vulkan extensions");
+        }
+        out[count++] = name;
+    }
+    return count;
+}
+
+}  // namespace cwin::vulkan
\ No newline at end of file
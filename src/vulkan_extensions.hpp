@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#ifndef CPPWINDOW_HEADER_VULKAN_EXTENSIONS_HPP
+#define CPPWINDOW_HEADER_VULKAN_EXTENSIONS_HPP
+
+#include <cstddef>
+#include <span>
+
+namespace cwin::vulkan {
+
+// Writes `required` followed by every entry of `requested` not already
+// written into `out` and returns the number written. Names are compared by
+// content. Throws std::out_of_range if `out` is too small.
+size_t mergeExtensions(
+    std::span<const char* const> required,
+    std::span<const char* const> requested,
+    std::span<const char*> out);
+
+}  // namespace cwin::vulkan
+
+#endif
\ No newline at end of file
@@ -6,7 +6,12 @@
 #ifndef CPPWINDOW_HEADER_WINDOW_REGISTRY_HPP
 #define CPPWINDOW_HEADER_WINDOW_REGISTRY_HPP
 
-#include <mutex>
+#include <cppwindow/cppwindow.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace cwin {
@@ -16,45 +21,124 @@ concept TypeHasResetFn = requires(T t) {
     { t.reset() };
 };
 
+// Window ids double as registry handles
+using StorageHandle = WindowId;
+
+// Generational slot map. Entries live packed in one array, handles go through
+// an indirection table that survives the swap-and-pop on destroy. Entries
+// that received data are queued once per frame so only those are reset.
+// Main thread only, there is no locking.
 template <TypeHasResetFn T>
 class WindowStorageRegistry
 {
 public:
-    void registerStorage(const std::shared_ptr<T>& storage)
+    static_assert(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+        "entries are moved whenever the dense array grows or shrinks");
+
+    StorageHandle create()
     {
-        std::lock_guard lock(mtx_);
-        if (tail_ < storageRefs_.size()) {
-            storageRefs_[tail_] = storage;
+        uint32_t index;
+        if (freeHead_ != StorageHandle::InvalidIndex) {
+            index = freeHead_;
+            freeHead_ = slots_[index].next;
         } else {
-            storageRefs_.push_back(storage);
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+
+        Slot& slot = slots_[index];
+        slot.next = static_cast<uint32_t>(dense_.size());
+        dense_.emplace_back();
+        denseToSlot_.push_back(index);
+        return StorageHandle{ index, slot.generation };
+    }
+
+    void destroy(StorageHandle handle) noexcept
+    {
+        if (!contains(handle)) {
+            return;
+        }
+        Slot& slot = slots_[handle.index];
+        uint32_t denseIndex = slot.next;
+        uint32_t lastIndex = static_cast<uint32_t>(dense_.size() - 1);
+
+        // fill the hole with the last entry to keep the array packed
+        if (denseIndex != lastIndex) {
+            dense_[denseIndex] = std::move(dense_[lastIndex]);
+            denseToSlot_[denseIndex] = denseToSlot_[lastIndex];
+            slots_[denseToSlot_[denseIndex]].next = denseIndex;
+        }
+        dense_.pop_back();
+        denseToSlot_.pop_back();
+
+        if (slot.dirty) {
+            std::erase(dirty_, handle);
+            slot.dirty = false;
+        }
+
+        // invalidate outstanding handles and put the slot on the free list
+        ++slot.generation;
+        slot.next = freeHead_;
+        freeHead_ = handle.index;
+    }
+
+    bool contains(StorageHandle handle) const noexcept
+    {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+    }
+
+    // nullptr for stale handles. The pointer is invalidated by create and destroy.
+    T* get(StorageHandle handle) noexcept
+    {
+        if (!contains(handle)) {
+            return nullptr;
         }
-        ++tail_;
+        return &dense_[slots_[handle.index].next];
     }
 
-    void resetAll()
-    {
-        std::lock_guard lock(mtx_);
-        size_t newTail = 0;
-
-        for (size_t i = 0; i < tail_; ++i) {
-            if (auto s = storageRefs_[i].lock()) {
-                s->reset();
-                // keep live entries at front
-                if (i != newTail) {
-                    storageRefs_[newTail] = storageRefs_[i];
-                }
-                ++newTail;
-            }
-            // expired entries are ignored
+    // Queues the entry for the next resetDirty, cheap after the first call
+    void markDirty(StorageHandle handle)
+    {
+        Slot& slot = slots_[handle.index];
+        if (!slot.dirty) {
+            slot.dirty = true;
+            dirty_.push_back(handle);
         }
-        // set tail to first free slot
-        tail_ = newTail;
+    }
+
+    // Entries marked since the last resetDirty, in marking order
+    std::span<const StorageHandle> dirty() const noexcept
+    {
+        return dirty_;
+    }
+
+    void resetDirty()
+    {
+        // entries without new data were already reset when they last had some
+        for (StorageHandle handle : dirty_) {
+            Slot& slot = slots_[handle.index];
+            dense_[slot.next].reset();
+            slot.dirty = false;
+        }
+        dirty_.clear();
     }
 
 private:
-    std::vector<std::weak_ptr<T>> storageRefs_;
-    size_t tail_ = 0;
-    std::mutex mtx_;
+    struct Slot
+    {
+        // bumped on destroy
+        uint32_t generation = 0;
+        // index into dense_ while alive, next free slot otherwise
+        uint32_t next = StorageHandle::InvalidIndex;
+        bool dirty = false;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<T> dense_;
+    std::vector<uint32_t> denseToSlot_;
+    std::vector<StorageHandle> dirty_;
+    uint32_t freeHead_ = StorageHandle::InvalidIndex;
 };
 
 }  // namespace cwin
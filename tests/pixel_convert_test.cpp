@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "pixel_convert.hpp"
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+using namespace cwin;
+
+namespace {
+
+// Every (colour, alpha) pair once per channel. The channels walk the colour
+// range in different orders so a swapped or shifted channel shows up.
+std::vector<uint8_t> makeAllPairs()
+{
+    std::vector<uint8_t> pixels;
+    pixels.reserve(256 * 256 * 4);
+    for (unsigned alpha = 0; alpha < 256; ++alpha) {
+        for (unsigned color = 0; color < 256; ++color) {
+            pixels.push_back(static_cast<uint8_t>(color));
+            pixels.push_back(static_cast<uint8_t>(255 - color));
+            pixels.push_back(static_cast<uint8_t>(color * 7));
+            pixels.push_back(static_cast<uint8_t>(alpha));
+        }
+    }
+    return pixels;
+}
+
+bool compare(const char* name, std::span<const uint8_t> actual, std::span<const uint8_t> expected)
+{
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (actual[i] != expected[i]) {
+            size_t pixel = i / 4;
+            std::printf(
+                "%s: pixel %zu channel %zu is %u, expected %u (source alpha %zu)\n",
+                name,
+                pixel,
+                i % 4,
+                actual[i],
+                expected[i],
+                pixel / 256);
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    constexpr std::array Formats = {
+        std::pair{ PixelFormat::RGBA8, "RGBA8" },
+        std::pair{ PixelFormat::RGBA8Premultiplied, "RGBA8Premultiplied" },
+        std::pair{ PixelFormat::BGRA8, "BGRA8" },
+        std::pair{ PixelFormat::BGRA8Premultiplied, "BGRA8Premultiplied" },
+    };
+
+    std::vector<uint8_t> src = makeAllPairs();
+    std::vector<uint8_t> expected(src.size());
+    std::vector<uint8_t> actual(src.size());
+    bool ok = true;
+
+    for (auto [format, name] : Formats) {
+        pixels::convertToRGBA8Scalar(src, expected, format);
+
+        // the whole buffer runs through the vector kernel
+        pixels::convertToRGBA8(src, actual, format);
+        ok &= compare(name, actual, expected);
+
+        // odd lengths and offsets split it between kernel and scalar tail
+        for (size_t first = 0; first < 8; ++first) {
+            for (size_t count = 1; count < 24; ++count) {
+                std::span<const uint8_t> in(src.data() + first * 4, count * 4);
+                std::span<uint8_t> out(actual.data(), count * 4);
+                pixels::convertToRGBA8(in, out, format);
+                ok &= compare(name, out, { expected.data() + first * 4, count * 4 });
+            }
+        }
+    }
+
+    // the reference itself rounds half up: 1 * 255 / 6 = 42.5
+    std::array<uint8_t, 4> half = { 1, 1, 1, 6 };
+    std::array<uint8_t, 4> rounded{};
+    pixels::convertToRGBA8Scalar(half, rounded, PixelFormat::RGBA8Premultiplied);
+    if (rounded[0] != 43) {
+        std::printf("reference: 1 / 6 unpremultiplied to %u, expected 43\n", rounded[0]);
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
\ No newline at end of file
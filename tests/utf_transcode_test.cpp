@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "utf_transcode.hpp"
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace cwin;
+
+namespace {
+
+// Straightforward encoder the SSE2 fast path is checked against
+std::string encodeScalar(std::u32string_view src)
+{
+    std::string out;
+    for (char32_t c : src) {
+        if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+            c = 0xFFFD;
+        }
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+        } else if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+bool check(const char* name, std::u32string_view src)
+{
+    // appends after existing bytes, which must be left alone
+    std::vector<char> actual = { 'x', 'y' };
+    utf::appendUtf8(src, actual);
+    std::string expected = "xy" + encodeScalar(src);
+
+    if (std::string(actual.begin(), actual.end()) == expected) {
+        return true;
+    }
+    std::printf(
+        "%s: %zu code points gave %zu bytes, expected %zu\n",
+        name,
+        src.size(),
+        actual.size() - 2,
+        expected.size() - 2);
+    return false;
+}
+
+}  // namespace
+
+int main()
+{
+    // one of each encoded length, then the values that must be replaced
+    constexpr std::array<char32_t, 8> Wide = {
+        0xE9, 0x20AC, 0x1F600, 0x10FFFF, 0xD800, 0xDFFF, 0x110000, 0xFFFFFFFF,
+    };
+    bool ok = true;
+
+    // pure ASCII around the 4-lane register and 8 code point block sizes,
+    // covers the blocks and every length of scalar tail
+    for (size_t length = 0; length <= 33; ++length) {
+        std::u32string src;
+        for (size_t i = 0; i < length; ++i) {
+            src += static_cast<char32_t>('a' + i % 26);
+        }
+        ok &= check("ascii", src);
+    }
+
+    // one wide code point at every lane of both registers in a block, with
+    // ASCII blocks before and after so the fast path has to resume
+    for (char32_t wide : Wide) {
+        for (size_t lane = 0; lane < 24; ++lane) {
+            std::u32string src(24, U'k');
+            src[lane] = wide;
+            ok &= check("wide lane", src);
+        }
+    }
+
+    // highest ASCII value against the lowest wide one in each lane
+    for (size_t lane = 0; lane < 8; ++lane) {
+        std::u32string src(16, U'\x7F');
+        src[lane] = 0x80;
+        ok &= check("0x7F/0x80", src);
+    }
+
+    // short inputs that never reach the fast path
+    for (size_t length = 1; length <= 5; ++length) {
+        for (char32_t wide : Wide) {
+            ok &= check("short", std::u32string(length, wide));
+        }
+    }
+
+    // only 4-byte sequences, and wide code points in every position of a
+    // mixed run
+    ok &= check("4-byte", std::u32string(19, 0x1F600));
+    std::u32string mixed;
+    for (size_t i = 0; i < 64; ++i) {
+        mixed += i % 3 == 0 ? Wide[i % Wide.size()] : static_cast<char32_t>('0' + i % 10);
+    }
+    ok &= check("mixed", mixed);
+
+    return ok ? 0 : 1;
+}
\ No newline at end of file
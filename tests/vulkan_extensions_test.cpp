@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "vulkan_extensions.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+
+using namespace cwin;
+
+namespace {
+
+bool g_Ok = true;
+
+void expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("failed: %s\n", what);
+        g_Ok = false;
+    }
+}
+
+bool matches(std::span<const char*> merged, std::initializer_list<const char*> expected)
+{
+    if (merged.size() != expected.size()) {
+        return false;
+    }
+    auto it = expected.begin();
+    for (const char* name : merged) {
+        if (std::strcmp(name, *it++) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool throwsOutOfRange(
+    std::span<const char* const> required,
+    std::span<const char* const> requested,
+    std::span<const char*> out)
+{
+    try {
+        vulkan::mergeExtensions(required, requested, out);
+    } catch (const std::out_of_range&) {
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main()
+{
+    const std::array<const char*, 2> required = { "VK_KHR_surface", "VK_KHR_xcb_surface" };
+    std::array<const char*, 8> out{};
+
+    // duplicates are found by content, the caller's strings live elsewhere
+    std::string surface = "VK_KHR_surface";
+    const std::array<const char*, 4> requested = {
+        "VK_EXT_debug_utils",
+        surface.c_str(),
+        "VK_KHR_xcb_surface",
+        "VK_EXT_debug_utils",
+    };
+    size_t count = vulkan::mergeExtensions(required, requested, out);
+    expect(
+        matches(
+            std::span(out).first(count),
+            { "VK_KHR_surface", "VK_KHR_xcb_surface", "VK_EXT_debug_utils" }),
+        "required first, requested deduplicated after them");
+
+    // nothing requested, or nothing required
+    count = vulkan::mergeExtensions(required, {}, out);
+    expect(
+        matches(std::span(out).first(count), { "VK_KHR_surface", "VK_KHR_xcb_surface" }),
+        "required only");
+    count = vulkan::mergeExtensions({}, requested, out);
+    expect(
+        matches(
+            std::span(out).first(count),
+            { "VK_EXT_debug_utils", "VK_KHR_surface", "VK_KHR_xcb_surface" }),
+        "requested only, deduplicated among themselves");
+
+    // an exact fit succeeds, duplicates take no room
+    count = vulkan::mergeExtensions(required, requested, std::span(out).first(3));
+    expect(count == 3, "exact fit");
+    expect(throwsOutOfRange(required, requested, std::span(out).first(2)), "no room for requested");
+    expect(throwsOutOfRange(required, {}, std::span(out).first(1)), "no room for required");
+
+    return g_Ok ? 0 : 1;
+}
\ No newline at end of file
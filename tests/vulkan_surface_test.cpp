@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+// Creates real Vulkan surfaces on the headless platform through
+// VK_EXT_headless_surface, which Mesa's lavapipe provides without a GPU or
+// display server. Exits with SkipCode when no loader or ICD is available.
+
+#include <cppwindow/cppwindow.hpp>
+
+#include <dlfcn.h>
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+using namespace cwin;
+
+namespace {
+
+constexpr int SkipCode = 77;
+
+// The few Vulkan declarations used here, vulkan.h is not required
+using VkInstance = struct VkInstance_T*;
+using VkPhysicalDevice = struct VkPhysicalDevice_T*;
+using VkResult = int32_t;
+
+struct VkApplicationInfo
+{
+    int32_t sType;
+    const void* pNext;
+    const char* pApplicationName;
+    uint32_t applicationVersion;
+    const char* pEngineName;
+    uint32_t engineVersion;
+    uint32_t apiVersion;
+};
+
+struct VkInstanceCreateInfo
+{
+    int32_t sType;
+    const void* pNext;
+    uint32_t flags;
+    const VkApplicationInfo* pApplicationInfo;
+    uint32_t enabledLayerCount;
+    const char* const* ppEnabledLayerNames;
+    uint32_t enabledExtensionCount;
+    const char* const* ppEnabledExtensionNames;
+};
+
+constexpr int32_t StructureTypeApplicationInfo = 0;
+constexpr int32_t StructureTypeInstanceCreateInfo = 1;
+constexpr uint32_t ApiVersion10 = 1u << 22;
+
+using PFN_vkVoidFunction = void (*)();
+using PFN_vkGetInstanceProcAddr = PFN_vkVoidFunction (*)(VkInstance, const char*);
+using PFN_vkCreateInstance = VkResult (*)(const VkInstanceCreateInfo*, const void*, VkInstance*);
+using PFN_vkDestroyInstance = void (*)(VkInstance, const void*);
+using PFN_vkEnumeratePhysicalDevices = VkResult (*)(VkInstance, uint32_t*, VkPhysicalDevice*);
+using PFN_vkDestroySurfaceKHR = void (*)(VkInstance, VulkanHandle, const void*);
+
+bool g_Ok = true;
+
+void expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("failed: %s\n", what);
+        g_Ok = false;
+    }
+}
+
+int skip(const char* reason)
+{
+    std::printf("skipped: %s\n", reason);
+    return SkipCode;
+}
+
+template <typename Fn>
+Fn load(PFN_vkGetInstanceProcAddr getProcAddr, VkInstance instance, const char* name)
+{
+    return reinterpret_cast<Fn>(getProcAddr(instance, name));
+}
+
+void testSurfaces(VkInstance instance, PFN_vkDestroySurfaceKHR destroy)
+{
+    Window window = WindowBuilder().title("vulkan").size(64, 64).noAPI().hidden().build();
+
+    VulkanHandle surface = window.createVulkanSurface(instance);
+    expect(surface != 0, "surface created");
+
+    // an existing surface is destroyed and replaced
+    VkResult result = window.recreateVulkanSurface(instance, surface);
+    expect(result == 0, "recreate succeeds");
+    expect(surface != 0, "recreated surface set");
+    destroy(instance, surface, nullptr);
+
+    // without one a fresh surface is created
+    surface = 0;
+    result = window.recreateVulkanSurface(instance, surface);
+    expect(result == 0 && surface != 0, "recreate from nothing");
+    destroy(instance, surface, nullptr);
+}
+
+}  // namespace
+
+int main()
+{
+    void* loader = dlopen("libvulkan.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!loader) {
+        return skip("no Vulkan loader");
+    }
+    auto getProcAddr =
+        reinterpret_cast<PFN_vkGetInstanceProcAddr>(dlsym(loader, "vkGetInstanceProcAddr"));
+
+    ContextOptions options;
+    options.headless = true;
+    WindowContext& context = WindowContext::initialize(options);
+    if (!getProcAddr || !context.isVulkanSupported()) {
+        return skip("Vulkan unsupported");
+    }
+
+    // required surface extensions merged with a duplicate of one of them
+    const std::array<const char*, 1> requested = { "VK_KHR_surface" };
+    std::array<const char*, 16> extensions{};
+    size_t extensionCount = context.mergeVulkanExtensions(requested, extensions);
+    expect(
+        extensionCount == context.getRequiredVulkanInstanceExtensions().size(),
+        "requested duplicate merged away");
+
+    VkApplicationInfo app{};
+    app.sType = StructureTypeApplicationInfo;
+    app.pApplicationName = "cppwindow tests";
+    app.apiVersion = ApiVersion10;
+    VkInstanceCreateInfo info{};
+    info.sType = StructureTypeInstanceCreateInfo;
+    info.pApplicationInfo = &app;
+    info.enabledExtensionCount = static_cast<uint32_t>(extensionCount);
+    info.ppEnabledExtensionNames = extensions.data();
+
+    auto createInstance = load<PFN_vkCreateInstance>(getProcAddr, nullptr, "vkCreateInstance");
+    VkInstance instance = nullptr;
+    if (!createInstance || createInstance(&info, nullptr, &instance) != 0) {
+        return skip("no ICD with headless surface support");
+    }
+    auto destroyInstance = load<PFN_vkDestroyInstance>(getProcAddr, instance, "vkDestroyInstance");
+    auto enumerateDevices =
+        load<PFN_vkEnumeratePhysicalDevices>(getProcAddr, instance, "vkEnumeratePhysicalDevices");
+    auto destroySurface =
+        load<PFN_vkDestroySurfaceKHR>(getProcAddr, instance, "vkDestroySurfaceKHR");
+
+    uint32_t deviceCount = 0;
+    enumerateDevices(instance, &deviceCount, nullptr);
+    if (deviceCount == 0) {
+        destroyInstance(instance, nullptr);
+        return skip("no physical device");
+    }
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    enumerateDevices(instance, &deviceCount, devices.data());
+
+    // the headless platform presents from any queue family
+    for (VkPhysicalDevice device : devices) {
+        expect(context.isPresentationSupported(instance, device, 0), "presentation supported");
+    }
+
+    testSurfaces(instance, destroySurface);
+
+    destroyInstance(instance, nullptr);
+    return g_Ok ? 0 : 1;
+}
\ No newline at end of file
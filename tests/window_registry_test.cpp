@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Amit Kumar
+ * Licensed under the MIT License.
+ */
+
+#include "window_registry.hpp"
+
+#include <cstdio>
+
+using namespace cwin;
+
+namespace {
+
+struct Entry
+{
+    int value = 0;
+    int resets = 0;
+
+    void reset() noexcept
+    {
+        ++resets;
+    }
+};
+
+using Registry = WindowStorageRegistry<Entry>;
+
+bool g_Ok = true;
+
+void expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("failed: %s\n", what);
+        g_Ok = false;
+    }
+}
+
+// The handle resolves to the entry that was tagged with `value` on creation
+bool holds(Registry& registry, StorageHandle handle, int value)
+{
+    Entry* entry = registry.get(handle);
+    return entry && entry->value == value;
+}
+
+void testSwapPop()
+{
+    Registry registry;
+    StorageHandle a = registry.create();
+    StorageHandle b = registry.create();
+    StorageHandle c = registry.create();
+    registry.get(a)->value = 1;
+    registry.get(b)->value = 2;
+    registry.get(c)->value = 3;
+
+    // the last entry moves into b's place, its handle must follow it
+    registry.destroy(b);
+    expect(!registry.contains(b), "destroyed handle is stale");
+    expect(registry.get(b) == nullptr, "stale handle resolves to nothing");
+    expect(holds(registry, a, 1), "entry before the hole untouched");
+    expect(holds(registry, c, 3), "moved entry found through its old handle");
+
+    // and keeps following it through a second move
+    StorageHandle d = registry.create();
+    registry.get(d)->value = 4;
+    registry.destroy(a);
+    expect(holds(registry, c, 3), "entry found after moving twice");
+    expect(holds(registry, d, 4), "last entry found after filling a hole");
+
+    // destroying a stale handle again changes nothing
+    registry.destroy(a);
+    expect(holds(registry, c, 3) && holds(registry, d, 4), "double destroy is a no-op");
+}
+
+void testGeneration()
+{
+    Registry registry;
+    StorageHandle first = registry.create();
+    registry.destroy(first);
+
+    // the slot is reused under a new generation
+    StorageHandle second = registry.create();
+    expect(second.index == first.index, "freed slot reused");
+    expect(second.generation == first.generation + 1, "generation bumped on destroy");
+    expect(!registry.contains(first), "old generation rejected");
+    expect(registry.contains(second), "new generation accepted");
+
+    StorageHandle outOfRange{ 7, 0 };
+    expect(!registry.contains(outOfRange), "unknown slot rejected");
+    expect(!registry.contains(StorageHandle{}), "default handle rejected");
+}
+
+void testDirty()
+{
+    Registry registry;
+    StorageHandle a = registry.create();
+    StorageHandle b = registry.create();
+    StorageHandle c = registry.create();
+    registry.get(c)->value = 3;
+
+    registry.markDirty(a);
+    registry.markDirty(b);
+    registry.markDirty(b);
+    registry.markDirty(c);
+    expect(registry.dirty().size() == 3, "entry queued once however often marked");
+
+    // a dirty entry that goes away leaves the queue with it, and c, moved
+    // into its place, is still reset through its own slot
+    registry.destroy(b);
+    expect(registry.dirty().size() == 2, "destroyed entry dropped from the queue");
+    expect(registry.dirty()[0] == a && registry.dirty()[1] == c, "queue keeps marking order");
+
+    registry.resetDirty();
+    expect(registry.dirty().empty(), "queue empty after reset");
+    expect(registry.get(a)->resets == 1, "dirty entry reset");
+    expect(registry.get(c)->resets == 1 && holds(registry, c, 3), "moved dirty entry reset");
+
+    // untouched entries are left alone, reset entries can be marked again
+    StorageHandle d = registry.create();
+    registry.markDirty(a);
+    registry.resetDirty();
+    expect(registry.get(a)->resets == 2, "entry marked again after reset");
+    expect(registry.get(c)->resets == 1, "clean entry not reset");
+    expect(registry.get(d)->resets == 0, "new entry not reset");
+}
+
+}  // namespace
+
+int main()
+{
+    testSwapPop();
+    testGeneration();
+    testDirty();
+    return g_Ok ? 0 : 1;
+}
\ No newline at end of file